@@ -0,0 +1,104 @@
+//
+//  circular_array.cpp
+//  benchmarks
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+// Compares the random access and full iteration performance of a CircularArray
+// using the default (exact) capacity policy against one using the power of two
+// capacity policy. Both arrays are rotated so that the elements wrap around the
+// end of the underlying storage.
+//
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <kss/util/circular_array.hpp>
+
+using namespace std;
+using namespace kss::util::containers;
+
+namespace {
+    constexpr size_t numElements = 1000000;
+    constexpr unsigned numRepeats = 20;
+
+    template <class Fn>
+    double timeIt(Fn fn) {
+        const auto start = chrono::steady_clock::now();
+        for (unsigned i = 0; i < numRepeats; ++i) {
+            fn();
+        }
+        const auto elapsed = chrono::steady_clock::now() - start;
+        return chrono::duration<double, milli>(elapsed).count() / numRepeats;
+    }
+
+    template <class Array>
+    void fill(Array& ca) {
+        // Rotate by half the size so that the logical start is in the middle of the
+        // physical storage.
+        for (size_t i = 0; i < ca.capacity() / 2; ++i) {
+            ca.push_back(0);
+        }
+        for (size_t i = 0; i < ca.capacity() / 2; ++i) {
+            ca.pop_front();
+        }
+        for (size_t i = 0; i < numElements; ++i) {
+            ca.push_back(uint64_t(i));
+        }
+    }
+
+    // Volatile sink so that the compiler cannot discard the work.
+    volatile uint64_t sink = 0;
+
+    template <class Array>
+    void runBenchmark(const string& name, const vector<size_t>& indices) {
+        Array ca(numElements);
+        fill(ca);
+
+        const double randomMs = timeIt([&] {
+            uint64_t sum = 0;
+            for (size_t i : indices) { sum += ca[i]; }
+            sink = sum;
+        });
+        const double iterateMs = timeIt([&] {
+            uint64_t sum = 0;
+            for (uint64_t v : ca) { sum += v; }
+            sink = sum;
+        });
+        const double accumulateMs = timeIt([&] {
+            sink = accumulate(ca.begin(), ca.end(), uint64_t(0));
+        });
+
+        cout << left << setw(22) << name
+             << " capacity=" << setw(9) << ca.capacity()
+             << right << fixed << setprecision(3)
+             << " random[]=" << setw(8) << randomMs << "ms"
+             << " range-for=" << setw(8) << iterateMs << "ms"
+             << " accumulate=" << setw(8) << accumulateMs << "ms"
+             << endl;
+    }
+}
+
+int main() {
+    // A simple linear congruential generator so that both runs use the same indices.
+    vector<size_t> indices(numElements);
+    uint64_t x = 12345;
+    for (auto& i : indices) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        i = size_t(x >> 33) % numElements;
+    }
+
+    cout << "CircularArray<uint64_t> with " << numElements << " elements, "
+         << "average of " << numRepeats << " runs" << endl;
+    runBenchmark<CircularArray<uint64_t>>("ExactCapacity", indices);
+    runBenchmark<CircularArray<uint64_t, allocator<uint64_t>, PowerOfTwoCapacity>>("PowerOfTwoCapacity", indices);
+    return 0;
+}
@@ -0,0 +1,103 @@
+//
+//  flatsequentialmap.cpp
+//  benchmarks
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+// Compares the lookup and iteration performance of a FlatSequentialMap against
+// the map-backed SequentialMap (using both the default tree index and the hash
+// index) for small, medium and large maps.
+//
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <kss/util/flatsequentialmap.hpp>
+#include <kss/util/sequentialmap.hpp>
+
+using namespace std;
+using namespace kss::util::containers;
+
+namespace {
+    constexpr size_t numLookups = 1000000;
+
+    template <class Fn>
+    double timeIt(Fn fn) {
+        const auto start = chrono::steady_clock::now();
+        fn();
+        const auto elapsed = chrono::steady_clock::now() - start;
+        return chrono::duration<double, milli>(elapsed).count();
+    }
+
+    // Volatile sink so that the compiler cannot discard the work.
+    volatile uint64_t sink = 0;
+
+    template <class Map>
+    void runBenchmark(const string& name, const vector<pair<uint64_t, uint64_t>>& in,
+                      const vector<uint64_t>& lookups)
+    {
+        Map m;
+        const double loadMs = timeIt([&] {
+            Map tmp(in.begin(), in.end());
+            m.swap(tmp);
+        });
+        const double hitMs = timeIt([&] {
+            uint64_t sum = 0;
+            for (uint64_t k : lookups) { sum += m.find(k)->second; }
+            sink = sum;
+        });
+        const double missMs = timeIt([&] {
+            size_t n = 0;
+            for (uint64_t k : lookups) { n += m.count(k + 1); }
+            sink = n;
+        });
+        const double iterateMs = timeIt([&] {
+            uint64_t sum = 0;
+            for (auto it = m.begin(), last = m.end(); it != last; ++it) { sum += it->second; }
+            sink = sum;
+        });
+
+        cout << "  " << left << setw(20) << name
+             << right << fixed << setprecision(3)
+             << " load=" << setw(10) << loadMs << "ms"
+             << " hits=" << setw(9) << hitMs << "ms"
+             << " misses=" << setw(9) << missMs << "ms"
+             << " iterate=" << setw(9) << iterateMs << "ms"
+             << endl;
+    }
+
+    void runBenchmarks(size_t numElements) {
+        // A simple linear congruential generator so that all runs use the same keys.
+        // The keys are all even so that adding one always gives a miss.
+        vector<pair<uint64_t, uint64_t>> in(numElements);
+        uint64_t x = 12345;
+        for (size_t i = 0; i < numElements; ++i) {
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+            in[i] = make_pair((x >> 16) & ~uint64_t(1), uint64_t(i));
+        }
+        vector<uint64_t> lookups(numLookups);
+        for (auto& k : lookups) {
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+            k = in[size_t(x >> 33) % numElements].first;
+        }
+
+        cout << numElements << " elements, " << numLookups << " lookups" << endl;
+        runBenchmark<SequentialMap<uint64_t, uint64_t>>("SequentialMap", in, lookups);
+        runBenchmark<HashSequentialMap<uint64_t, uint64_t>>("HashSequentialMap", in, lookups);
+        runBenchmark<FlatSequentialMap<uint64_t, uint64_t>>("FlatSequentialMap", in, lookups);
+    }
+}
+
+int main() {
+    runBenchmarks(1000);
+    runBenchmarks(100000);
+    runBenchmarks(10000000);
+    return 0;
+}
@@ -0,0 +1,74 @@
+//
+//  format.cpp
+//  benchmarks
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+// Compares formatting a log line with strings::format against appending it with
+// strings::appendFormat, both to a reused buffer and to a single string that grows
+// to hold every line. The time per line should not depend on the number of lines.
+//
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <kss/util/stringutil.hpp>
+
+using namespace std;
+using namespace kss::util::strings;
+
+namespace {
+    // Volatile sink so that the compiler cannot discard the work.
+    volatile size_t sink = 0;
+
+    template <class Fn>
+    double nsPerLine(unsigned numLines, Fn fn) {
+        const auto start = chrono::steady_clock::now();
+        for (unsigned i = 0; i < numLines; ++i) {
+            fn(i);
+        }
+        const auto elapsed = chrono::steady_clock::now() - start;
+        return chrono::duration<double, nano>(elapsed).count() / numLines;
+    }
+
+    void runBenchmark(unsigned numLines) {
+        const double formatNs = nsPerLine(numLines, [](unsigned i) {
+            sink = format("%s [%u] %s: request took %.3f ms", "2026-10-16T05:51:20Z",
+                          i % 8, "INFO", i * 0.001).size();
+        });
+
+        string buffer;
+        const double reusedNs = nsPerLine(numLines, [&](unsigned i) {
+            buffer.clear();
+            appendFormat(buffer, "%s [%u] %s: request took %.3f ms", "2026-10-16T05:51:20Z",
+                         i % 8, "INFO", i * 0.001);
+            sink = buffer.size();
+        });
+
+        string log;
+        log.reserve(size_t(numLines) * 64);
+        const double growingNs = nsPerLine(numLines, [&](unsigned i) {
+            appendFormat(log, "%s [%u] %s: request took %.3f ms\n", "2026-10-16T05:51:20Z",
+                         i % 8, "INFO", i * 0.001);
+        });
+        sink = log.size();
+
+        cout << setw(8) << numLines << " lines" << fixed << setprecision(1)
+             << "  format=" << setw(7) << formatNs << "ns"
+             << "  appendFormat(reused)=" << setw(7) << reusedNs << "ns"
+             << "  appendFormat(growing)=" << setw(7) << growingNs << "ns"
+             << endl;
+    }
+}
+
+int main() {
+    cout << "Time per formatted log line" << endl;
+    for (unsigned numLines : { 10000U, 20000U, 40000U, 1000000U }) {
+        runBenchmark(numLines);
+    }
+    return 0;
+}
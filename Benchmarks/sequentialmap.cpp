@@ -0,0 +1,85 @@
+//
+//  sequentialmap.cpp
+//  benchmarks
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+// Compares the time taken to load a SequentialMap one item at a time against
+// loading it using the bulk insert, for both the tree and hash indexes. The keys
+// are loaded both in sorted and in random order.
+//
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <kss/util/sequentialmap.hpp>
+
+using namespace std;
+using namespace kss::util::containers;
+
+namespace {
+    constexpr size_t numElements = 1000000;
+    constexpr unsigned numRepeats = 5;
+
+    template <class Fn>
+    double timeIt(Fn fn) {
+        const auto start = chrono::steady_clock::now();
+        for (unsigned i = 0; i < numRepeats; ++i) {
+            fn();
+        }
+        const auto elapsed = chrono::steady_clock::now() - start;
+        return chrono::duration<double, milli>(elapsed).count() / numRepeats;
+    }
+
+    // Volatile sink so that the compiler cannot discard the work.
+    volatile size_t sink = 0;
+
+    template <class Map>
+    void runBenchmark(const string& name, const vector<pair<uint64_t, uint64_t>>& in) {
+        const double singleMs = timeIt([&] {
+            Map m;
+            for (const auto& p : in) { m.insert(p); }
+            sink = m.size();
+        });
+        const double bulkMs = timeIt([&] {
+            Map m(in.begin(), in.end());
+            sink = m.size();
+        });
+
+        cout << left << setw(22) << name
+             << right << fixed << setprecision(3)
+             << " insert(value)=" << setw(9) << singleMs << "ms"
+             << " insert(first,last)=" << setw(9) << bulkMs << "ms"
+             << endl;
+    }
+}
+
+int main() {
+    vector<pair<uint64_t, uint64_t>> sorted(numElements);
+    for (size_t i = 0; i < numElements; ++i) {
+        sorted[i] = make_pair(uint64_t(i) * 2, uint64_t(i));
+    }
+
+    // A simple linear congruential generator so that all runs use the same keys.
+    vector<pair<uint64_t, uint64_t>> random(numElements);
+    uint64_t x = 12345;
+    for (size_t i = 0; i < numElements; ++i) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        random[i] = make_pair(x >> 16, uint64_t(i));
+    }
+
+    cout << "SequentialMap<uint64_t, uint64_t> with " << numElements << " elements, "
+         << "average of " << numRepeats << " runs" << endl;
+    runBenchmark<SequentialMap<uint64_t, uint64_t>>("TreeIndex, sorted", sorted);
+    runBenchmark<SequentialMap<uint64_t, uint64_t>>("TreeIndex, random", random);
+    runBenchmark<HashSequentialMap<uint64_t, uint64_t>>("HashIndex, sorted", sorted);
+    runBenchmark<HashSequentialMap<uint64_t, uint64_t>>("HashIndex, random", random);
+    return 0;
+}
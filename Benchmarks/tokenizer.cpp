@@ -0,0 +1,87 @@
+//
+//  tokenizer.cpp
+//  benchmarks
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+// Measures the throughput of the Tokenizer, ViewTokenizer and parallelTokenize on a
+// large buffer of whitespace separated words and on one of comma separated fields.
+//
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <kss/util/tokenizer.hpp>
+
+using namespace std;
+using namespace kss::util::strings;
+
+namespace {
+    constexpr size_t bufferSize = 64 * 1024 * 1024;
+
+    template <class Fn>
+    double timeIt(Fn fn) {
+        const auto start = chrono::steady_clock::now();
+        fn();
+        const auto elapsed = chrono::steady_clock::now() - start;
+        return chrono::duration<double>(elapsed).count();
+    }
+
+    // Volatile sink so that the compiler cannot discard the work.
+    volatile size_t sink = 0;
+
+    string makeBuffer(const string& delims, size_t maxTokenLength) {
+        string buf;
+        buf.reserve(bufferSize + maxTokenLength + 1);
+        uint64_t x = 12345;
+        while (buf.size() < bufferSize) {
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+            buf.append(size_t(x >> 33) % maxTokenLength + 1, char('a' + (x >> 40) % 26));
+            buf.push_back(delims[(x >> 50) % delims.size()]);
+        }
+        return buf;
+    }
+
+    void runBenchmark(const string& name, const string& buf, const string& delims) {
+        const double mb = double(buf.size()) / (1024.0 * 1024.0);
+        size_t count = 0;
+        const double tokenizerSecs = timeIt([&] {
+            Tokenizer t(buf, delims);
+            string token;
+            size_t n = 0;
+            while (t.hasAnother()) { n += t.next(token).size(); }
+            sink = n;
+        });
+        const double viewSecs = timeIt([&] {
+            ViewTokenizer t(buf, delims);
+            stringview_t token;
+            size_t n = 0;
+            while (t.hasAnother()) { n += t.next(token).size(); ++count; }
+            sink = n;
+        });
+        const double parallelSecs = timeIt([&] {
+            sink = parallelTokenize(buf, delims).size();
+        });
+
+        cout << left << setw(12) << name
+             << right << fixed << setprecision(1)
+             << " tokens=" << setw(9) << count
+             << " Tokenizer=" << setw(7) << mb / tokenizerSecs << "MB/s"
+             << " ViewTokenizer=" << setw(7) << mb / viewSecs << "MB/s"
+             << " parallel=" << setw(7) << mb / parallelSecs << "MB/s"
+             << endl;
+    }
+}
+
+int main() {
+    const string ws(" \t\n");
+    const string csv(",\n");
+    runBenchmark("whitespace", makeBuffer(ws, 12), ws);
+    runBenchmark("csv", makeBuffer(csv, 40), csv);
+    return 0;
+}
@@ -24,7 +24,7 @@ void Attributes::setAttribute(const string &key, const string &value) {
     _attributes[key] = value;
 }
 
-bool Attributes::hasAttribute(const string &key) const {
+bool Attributes::hasAttribute(const string& key) const {
     contract::parameters({
         KSS_EXPR(!key.empty())
     });
@@ -32,6 +32,14 @@ bool Attributes::hasAttribute(const string &key) const {
     return (_attributes.find(key) != _attributes.end());
 }
 
+bool Attributes::hasAttribute(strings::stringview_t key) const {
+    contract::parameters({
+        KSS_EXPR(!key.empty())
+    });
+
+    return (_attributes.find(key.to_string()) != _attributes.end());
+}
+
 vector<string> Attributes::attributeKeys() const {
     vector<string> ret;
     ret.reserve(_attributes.size());
@@ -48,3 +56,7 @@ string Attributes::rawAttribute(const string& key) const {
     }
     return it->second;
 }
+
+string Attributes::rawAttribute(strings::stringview_t key) const {
+    return rawAttribute(key.to_string());
+}
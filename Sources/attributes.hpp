@@ -18,17 +18,39 @@
 #include <map>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "convert.hpp"
+#include "stringview.hpp"
 
 namespace kss { namespace util {
 
+    namespace _private {
+        // Enabled for the key types, other than std::string and stringview_t
+        // themselves, that are looked up through a stringview_t. Without it a string
+        // literal or SubString would be ambiguous between those two overloads.
+        template <class Key>
+        using enable_if_view_key_t = typename std::enable_if<
+            !std::is_same<Key, std::string>::value
+            && !std::is_same<Key, strings::stringview_t>::value
+            && std::is_convertible<const Key&, strings::stringview_t>::value
+        >::type;
+    }
+
     /*!
      \brief Adds an attribures API to subclasses.
 
      Base class used to add an attributes API to other classes. Simply subclass from
      this one in order to add the API.
+
+     An attribute may be looked up using a std::string, a string literal, a
+     SubString or a strings::stringview_t. A std::string key is used directly. Any
+     other key is copied into a temporary std::string, which allocates if the key
+     is too long for the small string buffer. The map keeps the default comparison
+     so that attribute_map_t remains std::map<std::string, std::string>, and without
+     a transparent comparison there is no way to avoid that copy. Lookups by view
+     are therefore convenient, but not allocation free.
      */
     class Attributes {
     public:
@@ -48,8 +70,8 @@ namespace kss { namespace util {
          @throws std::invalid_argument if the key is not currently in the attribute map.
          @throws std::system_error if the key exists but the value cannot be converted to type T.
          */
-        template <class T>
-        T attribute(const std::string& key) const {
+        template <class T, class Key>
+        T attribute(const Key& key) const {
             const auto ra = rawAttribute(key);
             return strings::convert<T>(ra);
         }
@@ -59,9 +81,8 @@ namespace kss { namespace util {
          to the type T.
          @throws any exception thrown by the attribute() method
          */
-        template <class T>
-        inline T attributeWithDefault(const std::string& key,
-                                      const T& defaultValue = T()) const
+        template <class T, class Key>
+        inline T attributeWithDefault(const Key& key, const T& defaultValue = T()) const
         {
             return (hasAttribute(key) ? attribute<T>(key) : defaultValue);
         }
@@ -71,6 +92,12 @@ namespace kss { namespace util {
          @throws std::invalid_argument if key is empty
          */
         bool hasAttribute(const std::string& key) const;
+        bool hasAttribute(strings::stringview_t key) const;
+
+        template <class Key, class = _private::enable_if_view_key_t<Key>>
+        inline bool hasAttribute(const Key& key) const {
+            return hasAttribute(strings::stringview_t(key));
+        }
 
         /*!
          Read-only access to the attribute map.
@@ -97,6 +124,12 @@ namespace kss { namespace util {
          @throws std::invalid_argument if the key is not currently in the attribute map.
          */
         std::string rawAttribute(const std::string& key) const;
+        std::string rawAttribute(strings::stringview_t key) const;
+
+        template <class Key, class = _private::enable_if_view_key_t<Key>>
+        inline std::string rawAttribute(const Key& key) const {
+            return rawAttribute(strings::stringview_t(key));
+        }
 
         /*!
          Write access to the attribute map.
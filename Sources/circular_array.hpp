@@ -15,6 +15,7 @@
 #include <iterator>
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
 #include <kss/contract/all.h>
@@ -30,6 +31,45 @@
 
 namespace kss { namespace util { namespace containers {
 
+    /*!
+     \brief Capacity policy that uses the capacity exactly as requested.
+
+     This is the default capacity policy for CircularArray. Logical positions are
+     mapped to physical slots using a compare and subtract.
+     */
+    struct ExactCapacity {
+        template <class SizeT>
+        static inline SizeT adjust(SizeT cap) noexcept { return cap; }
+
+        // pos must be less than twice cap.
+        template <class SizeT>
+        static inline SizeT wrap(SizeT pos, SizeT cap) noexcept {
+            return (pos >= cap ? pos - cap : pos);
+        }
+    };
+
+    /*!
+     \brief Capacity policy that rounds the capacity up to a power of two.
+
+     This trades some memory for speed. Since the capacity is always a power of two,
+     logical positions are mapped to physical slots using a mask instead of a compare
+     and subtract. This is most noticeable in code that makes heavy use of random
+     access (operator[], at(), and iterator dereferencing).
+     */
+    struct PowerOfTwoCapacity {
+        template <class SizeT>
+        static inline SizeT adjust(SizeT cap) noexcept {
+            SizeT ret = 1;
+            while (ret < cap) { ret <<= 1; }
+            return (cap == 0 ? 0 : ret);
+        }
+
+        template <class SizeT>
+        static inline SizeT wrap(SizeT pos, SizeT cap) noexcept {
+            return (pos & (cap - 1));
+        }
+    };
+
     /*!
      \brief Almost contiguous array referenced in a circular manner.
 
@@ -62,22 +102,30 @@ namespace kss { namespace util { namespace containers {
      - Stack and Queue (push_back,pop_back,push_front,pop_front) - O(1)
      - List Operations (clear) - O(n)
      - Iterators - O(1)
+
+     The CapacityPolicy determines how the requested capacity is turned into the
+     actual capacity, and how logical positions are mapped onto physical slots. It
+     should be either ExactCapacity (the default) or PowerOfTwoCapacity. Note that
+     with PowerOfTwoCapacity the capacity() may be larger than what was requested.
      */
-    template <class T, class A = std::allocator<T>>
-    class CircularArray : public kss::util::AddRelOps<CircularArray<T, A>> {
+    template <class T, class A = std::allocator<T>, class CapacityPolicy = ExactCapacity>
+    class CircularArray : public kss::util::AddRelOps<CircularArray<T, A, CapacityPolicy>> {
     public:
         using value_type = T;
         using allocator_type = A;
+        using capacity_policy = CapacityPolicy;
         using size_type = typename A::size_type;
         using difference_type = typename A::difference_type;
-        using iterator = kss::util::iterators::RandomAccessIterator<CircularArray>;
-        using const_iterator = kss::util::iterators::ConstRandomAccessIterator<CircularArray>;
+        using iterator = kss::util::iterators::CircularIterator<CircularArray>;
+        using const_iterator = kss::util::iterators::ConstCircularIterator<CircularArray>;
         using reverse_iterator = std::reverse_iterator<iterator>;
         using const_reverse_iterator = std::reverse_iterator<const_iterator>;
         using pointer = typename A::pointer;
         using const_pointer = typename A::const_pointer;
         using reference = typename A::reference;
         using const_reference = typename A::const_reference;
+        using array_range = std::pair<pointer, size_type>;
+        using const_array_range = std::pair<const_pointer, size_type>;
 
         /*!
          Construct a circular array. Note that the InputIterator version may reallocate
@@ -91,7 +139,7 @@ namespace kss { namespace util { namespace containers {
 
             kss::contract::postconditions({
                 KSS_EXPR(_array != nullptr),
-                KSS_EXPR(_capacity == cap),
+                KSS_EXPR(_capacity == CapacityPolicy::adjust(cap)),
                 KSS_EXPR(_size == 0),
                 KSS_EXPR(_first == 0),
                 KSS_EXPR(_last == _size)
@@ -109,7 +157,7 @@ namespace kss { namespace util { namespace containers {
 
             kss::contract::postconditions({
                 KSS_EXPR(_array != nullptr),
-                KSS_EXPR(_capacity == std::max(n, cap)),
+                KSS_EXPR(_capacity == CapacityPolicy::adjust(std::max(n, cap))),
                 KSS_EXPR(_size == n),
                 KSS_EXPR(_first == 0),
                 KSS_EXPR((_last == _size) || (_last == 0 && _size == _capacity))
@@ -142,10 +190,12 @@ namespace kss { namespace util { namespace containers {
         {
             init(std::max(ca.size(), cap));
             assign(ca.begin(), ca.end());
+            _overwriting = ca._overwriting;
+            _evictions = ca._evictions;
 
             kss::contract::postconditions({
                 KSS_EXPR(_array != nullptr),
-                KSS_EXPR(_capacity == std::max(ca.size(), cap)),
+                KSS_EXPR(_capacity == CapacityPolicy::adjust(std::max(ca.size(), cap))),
                 KSS_EXPR(_size == ca.size()),
                 KSS_EXPR(_first == 0),
                 KSS_EXPR((_last == _size) || (_last == 0 && _size == _capacity)),
@@ -160,9 +210,12 @@ namespace kss { namespace util { namespace containers {
             _last = ca._last;
             _size = ca._size;
             _allocator = ca._allocator;
+            _overwriting = ca._overwriting;
+            _evictions = ca._evictions;
 
             ca._array = nullptr;
             ca._capacity = ca._first = ca._last = ca._size = 0;
+            ca._evictions = 0;
 
             kss::contract::postconditions({
                 KSS_EXPR(_array != nullptr),
@@ -184,7 +237,7 @@ namespace kss { namespace util { namespace containers {
 
             kss::contract::postconditions({
                 KSS_EXPR(_array != nullptr),
-                KSS_EXPR(_capacity == std::max(il.size(), cap)),
+                KSS_EXPR(_capacity == CapacityPolicy::adjust(std::max(il.size(), cap))),
                 KSS_EXPR(_size == il.size()),
                 KSS_EXPR(_first == 0),
                 KSS_EXPR((_last == _size) || (_last == 0 && _size == _capacity))
@@ -207,6 +260,8 @@ namespace kss { namespace util { namespace containers {
                 for (const value_type& v : ca) {
                     push_back(v);
                 }
+                _overwriting = ca._overwriting;
+                _evictions = ca._evictions;
             }
 
             kss::contract::postconditions({
@@ -226,7 +281,10 @@ namespace kss { namespace util { namespace containers {
                 _last = ca._last;
                 _size = ca._size;
                 _allocator = ca._allocator;
+                _overwriting = ca._overwriting;
+                _evictions = ca._evictions;
                 ca.teardown();
+                ca._evictions = 0;
             }
 
             kss::contract::postconditions({
@@ -257,7 +315,9 @@ namespace kss { namespace util { namespace containers {
 
         void assign(size_type n, const value_type& val) {
             clear();
-            reserve(n);
+            if (!_overwriting) {
+                reserve(n);
+            }
             for (size_type i = 0; i < n; ++i) {
                 push_back(val);
             }
@@ -265,31 +325,36 @@ namespace kss { namespace util { namespace containers {
             kss::contract::postconditions({
                 KSS_EXPR(_array != nullptr),
                 KSS_EXPR(_capacity >= _size),
-                KSS_EXPR(_size == n)
+                KSS_EXPR((_size == n) || (_overwriting && _size == _capacity))
             });
         }
 
         void assign(std::initializer_list<value_type> il) {
             clear();
-            reserve(il.size());
+            if (!_overwriting) {
+                reserve(il.size());
+            }
             assign(il.begin(), il.end());
 
             kss::contract::postconditions({
                 KSS_EXPR(_array != nullptr),
                 KSS_EXPR(_capacity >= _size),
-                KSS_EXPR(_size == il.size())
+                KSS_EXPR((_size == il.size()) || (_overwriting && _size == _capacity))
             });
         }
 
         /*!
          Iterators. Note that these satisfy the requirements of a random access iterator.
+         They walk a pointer through the underlying storage, only checking for the
+         wrap-around at its end. For the tightest possible loops, use array_one() and
+         array_two() instead.
          */
-        iterator begin()                                { return iterator(*this); }
-        iterator end()                                  { return iterator(*this, true); }
-        const_iterator begin() const                    { return const_iterator(*this); }
-        const_iterator end() const                      { return const_iterator(*this, true); }
-        const_iterator cbegin() const                   { return const_iterator(*this); }
-        const_iterator cend() const                     { return const_iterator(*this, true); }
+        iterator begin() noexcept                       { return iterator(_array, _capacity, _first, 0); }
+        iterator end() noexcept                         { return iterator(_array, _capacity, _last, _size); }
+        const_iterator begin() const noexcept           { return const_iterator(_array, _capacity, _first, 0); }
+        const_iterator end() const noexcept             { return const_iterator(_array, _capacity, _last, _size); }
+        const_iterator cbegin() const noexcept          { return begin(); }
+        const_iterator cend() const noexcept            { return end(); }
         reverse_iterator rbegin() noexcept              { return reverse_iterator(end()); }
         reverse_iterator rend() noexcept                { return reverse_iterator(begin()); }
         const_reverse_iterator rbegin() const noexcept  { return const_reverse_iterator(end()); }
@@ -302,7 +367,9 @@ namespace kss { namespace util { namespace containers {
          shrink the capacity. Similarly reserve will grow the allowable space, but
          will never shrink it. The only way to shrink the actual memory used is to
          call shrink_to_fit() which will temporarily allocate more memory before
-         completing the shrink. (i.e. It does not shrink "in place.")
+         completing the shrink. (i.e. It does not shrink "in place.") When the memory
+         is reallocated the elements are moved, unless their move constructor may
+         throw, in which case they are copied.
          */
         size_type size() const noexcept     { return _size; }
         size_type max_size() const noexcept { return _allocator.max_size(); }
@@ -330,8 +397,7 @@ namespace kss { namespace util { namespace containers {
                 return;
             }
 
-            CircularArray ca(*this, cap, _allocator);
-            swap(ca);
+            reallocate(cap);
 
             kss::contract::postconditions({
                 KSS_EXPR(_array != nullptr),
@@ -341,13 +407,12 @@ namespace kss { namespace util { namespace containers {
         }
 
         void shrink_to_fit() {
-            if (capacity() > size()) {
-                CircularArray tmp(*this, size(), _allocator);
-                swap(tmp);
+            if (capacity() > CapacityPolicy::adjust(size())) {
+                reallocate(size());
             }
 
             kss::contract::postconditions({
-                KSS_EXPR(_capacity == _size)
+                KSS_EXPR(_capacity == CapacityPolicy::adjust(_size))
             });
         }
 
@@ -362,15 +427,12 @@ namespace kss { namespace util { namespace containers {
                 KSS_EXPR(_size > n)
             });
 
-            size_type pos = _first + n;
-            if (pos >= _capacity) {
-                pos -= _capacity;
-            }
+            const size_type pos = CapacityPolicy::wrap(_first + n, _capacity);
 
             // postconditions
             kss::contract::postconditions({
                 KSS_EXPR((pos >= _first && pos < _capacity)
-                         || (pos < _last && _first > _last)
+                         || (pos < _last && _first >= _last)
                          || (pos >= _first && pos < _last))
             });
             return _array[pos];
@@ -382,14 +444,11 @@ namespace kss { namespace util { namespace containers {
                 KSS_EXPR(_size > n)
             });
 
-            size_type pos = _first + n;
-            if (pos >= _capacity) {
-                pos -= _capacity;
-            }
+            const size_type pos = CapacityPolicy::wrap(_first + n, _capacity);
 
             kss::contract::postconditions({
                 KSS_EXPR((pos >= _first && pos < _capacity)
-                         || (pos < _last && _first > _last)
+                         || (pos < _last && _first >= _last)
                          || (pos >= _first && pos < _last))
             });
             return _array[pos];
@@ -403,14 +462,11 @@ namespace kss { namespace util { namespace containers {
             if (n >= _size) {
                 throw std::out_of_range("n is out of range of this circular_array");
             }
-            size_type pos = _first + n;
-            if (pos >= _capacity) {
-                pos -= _capacity;
-            }
+            const size_type pos = CapacityPolicy::wrap(_first + n, _capacity);
 
             kss::contract::postconditions({
                 KSS_EXPR((pos >= _first && pos < _capacity)
-                         || (pos < _last && _first > _last)
+                         || (pos < _last && _first >= _last)
                          || (pos >= _first && pos < _last))
             });
             return _array[pos];
@@ -424,14 +480,11 @@ namespace kss { namespace util { namespace containers {
             if (n >= _size) {
                 throw std::out_of_range("n is out of range of this circular_array");
             }
-            size_type pos = _first + n;
-            if (pos >= _capacity) {
-                pos -= _capacity;
-            }
+            const size_type pos = CapacityPolicy::wrap(_first + n, _capacity);
 
             kss::contract::postconditions({
                 KSS_EXPR((pos >= _first && pos < _capacity)
-                         || (pos < _last && _first > _last)
+                         || (pos < _last && _first >= _last)
                          || (pos >= _first && pos < _last))
             });
             return _array[pos];
@@ -461,12 +514,7 @@ namespace kss { namespace util { namespace containers {
                 KSS_EXPR(_size > 0)
             });
 
-            if (_last == 0) {
-                return _array[_capacity-1];
-            }
-            else {
-                return _array[_last - 1];
-            }
+            return _array[CapacityPolicy::wrap(_last + _capacity - 1, _capacity)];
         }
 
         const_reference back() const noexcept {
@@ -475,21 +523,42 @@ namespace kss { namespace util { namespace containers {
                 KSS_EXPR(_size > 0)
             });
 
-            if (_last == 0) {
-                return _array[_capacity-1];
-            }
-            else {
-                return _array[_last - 1];
-            }
+            return _array[CapacityPolicy::wrap(_last + _capacity - 1, _capacity)];
+        }
+
+        /*!
+         Contiguous views. The elements are stored in at most two contiguous spans.
+         array_one() returns the span starting with front() and array_two() returns
+         the wrapped span (if any) ending with back(). Each is returned as a pointer
+         and a count. Either may have a count of zero, and array_two() will only be
+         non-empty if array_one() is also non-empty.
+
+         The pointers are invalidated by any operation that changes the capacity or
+         that removes the elements they point to.
+         */
+        array_range array_one() noexcept {
+            return array_range(_array+_first, first_span_size());
+        }
+
+        array_range array_two() noexcept {
+            return array_range(_array, _size - first_span_size());
+        }
+
+        const_array_range array_one() const noexcept {
+            return const_array_range(_array+_first, first_span_size());
+        }
+
+        const_array_range array_two() const noexcept {
+            return const_array_range(_array, _size - first_span_size());
         }
 
         /*!
          Modifiers. these will not increase the capacity. Attempting to add an item
-         when we have already reached capacity will throw an exception.
+         when we have already reached capacity will throw an exception, unless the
+         array is in overwriting mode. (See set_overwriting().)
          */
         void push_back(const value_type& val) {
-            value_type v(val);
-            push_back(std::move(v));
+            emplace_back(val);
 
             kss::contract::postconditions({
                 KSS_EXPR(back() == val)
@@ -497,12 +566,31 @@ namespace kss { namespace util { namespace containers {
         }
 
         void push_back(value_type&& val) {
-            check_room_for_one_more();
-            _allocator.construct(_array+_last, val);
-            ++_last;
-            ++_size;
-            if (_last >= _capacity) {
-                _last = 0;
+            emplace_back(std::move(val));
+        }
+
+        /*!
+         Construct a new element in place at the back of the array. The arguments are
+         forwarded to the value_type constructor via the allocator. If that throws an
+         exception the array is left unchanged.
+
+         In overwriting mode, when the array is full, the new element is first
+         constructed as a temporary, so the arguments may refer to the element being
+         evicted (e.g. push_back(front())), and then moved into place. If that move
+         throws an exception the evicted element is not restored.
+         @throws std::length_error if the array is already full and not overwriting.
+         */
+        template <class... Args>
+        void emplace_back(Args&&... args) {
+            if (_overwriting && _size == _capacity && _capacity > 0) {
+                value_type tmp(std::forward<Args>(args)...);
+                pop_front();
+                ++_evictions;
+                construct_back(std::move(tmp));
+            }
+            else {
+                check_room_for_one_more();
+                construct_back(std::forward<Args>(args)...);
             }
 
             kss::contract::postconditions({
@@ -518,7 +606,7 @@ namespace kss { namespace util { namespace containers {
                 KSS_EXPR(_size > 0)
             });
 
-            _last = (_last == 0 ? _capacity - 1 : _last - 1);
+            _last = CapacityPolicy::wrap(_last + _capacity - 1, _capacity);
             --_size;
             _allocator.destroy(_array+_last);
 
@@ -529,8 +617,7 @@ namespace kss { namespace util { namespace containers {
         }
 
         void push_front(const value_type& val) {
-            value_type v(val);
-            push_front(std::move(v));
+            emplace_front(val);
 
             kss::contract::postconditions({
                 KSS_EXPR(front() == val)
@@ -538,10 +625,27 @@ namespace kss { namespace util { namespace containers {
         }
 
         void push_front(value_type&& val) {
-            check_room_for_one_more();
-            _first = (_first == 0 ? _capacity - 1 : _first - 1);
-            ++_size;
-            _allocator.construct(_array+_first, val);
+            emplace_front(std::move(val));
+        }
+
+        /*!
+         Construct a new element in place at the front of the array. This behaves as
+         emplace_back, including the handling of an evicted element, which here is
+         the back (e.g. push_front(back())).
+         @throws std::length_error if the array is already full and not overwriting.
+         */
+        template <class... Args>
+        void emplace_front(Args&&... args) {
+            if (_overwriting && _size == _capacity && _capacity > 0) {
+                value_type tmp(std::forward<Args>(args)...);
+                pop_back();
+                ++_evictions;
+                construct_front(std::move(tmp));
+            }
+            else {
+                check_room_for_one_more();
+                construct_front(std::forward<Args>(args)...);
+            }
 
             kss::contract::postconditions({
                 KSS_EXPR(_array != nullptr),
@@ -557,11 +661,8 @@ namespace kss { namespace util { namespace containers {
             });
 
             _allocator.destroy(_array+_first);
-            ++_first;
+            _first = CapacityPolicy::wrap(_first + 1, _capacity);
             --_size;
-            if (_first >= _capacity) {
-                _first = 0;
-            }
 
             kss::contract::postconditions({
                 KSS_EXPR(_array != nullptr),
@@ -569,6 +670,65 @@ namespace kss { namespace util { namespace containers {
             });
         }
 
+        /*!
+         Bulk modifiers. append adds the elements [first,last) to the back of the array
+         and consume removes the first n elements, writing them to out. Both work on
+         at most two contiguous spans instead of element by element, which for
+         trivially copyable types reduces them to block copies.
+
+         If given forward iterators, append will check that there is enough room
+         before adding anything, and if an exception is thrown the array will be
+         unchanged, except that in overwriting mode any elements evicted to make room
+         are not restored. (They are evicted before the new elements are copied, so
+         in overwriting mode [first,last) must not refer to elements of the array.)
+         With input iterators the elements are pushed one at a time and any that were
+         added before an exception will remain.
+
+         consume moves the elements into out. If that throws an exception the array is
+         left unchanged, but some of its elements may be in a moved-from state.
+
+         @throws std::length_error if there is not enough room for the new elements.
+         @throws std::invalid_argument if n > size().
+         @throws any exceptions that value_type constructors or out may throw.
+         */
+        template <class InputIterator>
+        void append(InputIterator first, InputIterator last) {
+            append(first, last, typename std::iterator_traits<InputIterator>::iterator_category());
+
+            kss::contract::postconditions({
+                KSS_EXPR(_array != nullptr),
+                KSS_EXPR(_capacity >= _size)
+            });
+        }
+
+        template <class OutputIterator>
+        OutputIterator consume(size_type n, OutputIterator out) {
+            kss::contract::parameters({
+                KSS_EXPR(n <= _size)
+            });
+
+            const size_type n1 = std::min(n, first_span_size());
+            out = std::move(_array+_first, _array+_first+n1, out);
+            out = std::move(_array, _array+(n-n1), out);
+
+            using kss::util::memory::destroy;
+            destroy(_array+_first, _array+_first+n1, _allocator);
+            destroy(_array, _array+(n-n1), _allocator);
+            _size -= n;
+            if (_size == 0) {
+                _first = _last = 0;
+            }
+            else {
+                _first = CapacityPolicy::wrap(_first + n, _capacity);
+            }
+
+            kss::contract::postconditions({
+                KSS_EXPR(_array != nullptr),
+                KSS_EXPR(_capacity >= _size)
+            });
+            return out;
+        }
+
         void swap(CircularArray& ca) noexcept {
             if (&ca != this) {
                 std::swap(_array, ca._array);
@@ -577,18 +737,13 @@ namespace kss { namespace util { namespace containers {
                 std::swap(_last, ca._last);
                 std::swap(_size, ca._size);
                 std::swap(_allocator, ca._allocator);
+                std::swap(_overwriting, ca._overwriting);
+                std::swap(_evictions, ca._evictions);
             }
         }
 
         void clear() noexcept {
-            using kss::util::memory::destroy;
-            if (_first < _last) {
-                destroy(_array+_first, _array+_last, _allocator);
-            }
-            else if (_last < _first) {
-                destroy(_array+_first, _array+_capacity, _allocator);
-                destroy(_array, _array+_last, _allocator);
-            }
+            destroy_all();
             _first = _last = _size = 0;
 
             kss::contract::postconditions({
@@ -603,6 +758,24 @@ namespace kss { namespace util { namespace containers {
          */
         allocator_type get_allocator() const noexcept { return _allocator; }
 
+        /*!
+         Overwriting mode. By default adding an element to a full array throws an
+         exception. When overwriting is turned on, push_back and emplace_back will
+         instead evict the front element, and push_front and emplace_front will evict
+         the back element, in O(1) time. The assign methods will also no longer grow
+         the capacity, keeping only the last capacity() elements, and append will
+         evict what it needs to make room. In this mode the array will not allocate
+         memory unless you explicitly call reserve, resize or shrink_to_fit.
+
+         evictions() returns the number of elements that have been discarded to make
+         room since the array was created or reset_evictions() was last called. The
+         mode and the count are carried by copies, moves and swaps.
+         */
+        void set_overwriting(bool overwriting) noexcept { _overwriting = overwriting; }
+        bool overwriting() const noexcept               { return _overwriting; }
+        size_type evictions() const noexcept            { return _evictions; }
+        void reset_evictions() noexcept                 { _evictions = 0; }
+
         /*!
          Relational operators. These perform a lexicographical_compare. The remainder
          of the operators are provided by AddRelOps
@@ -626,6 +799,7 @@ namespace kss { namespace util { namespace containers {
 
     private:
         void init(size_type cap) {
+            cap = CapacityPolicy::adjust(cap);
             _array = _allocator.allocate(cap);
             _capacity = cap;
             _first = _last = _size = 0;
@@ -633,20 +807,139 @@ namespace kss { namespace util { namespace containers {
 
         void teardown() {
             if (_array) {
-                using kss::util::memory::destroy;
-                if (_first < _last) {
-                    destroy(_array+_first, _array+_last, _allocator);
-                }
-                else if (_last < _first) {
-                    destroy(_array+_first, _array+_capacity, _allocator);
-                    destroy(_array, _array+_last, _allocator);
-                }
+                destroy_all();
                 _allocator.deallocate(_array, _capacity);
                 _array = nullptr;
             }
         }
 
+        // Move the elements into new storage with the given capacity. Elements whose
+        // move constructor may throw are copied instead, so if an exception is thrown
+        // the array is left unchanged.
+        void reallocate(size_type cap) {
+            CircularArray tmp(cap, _allocator);
+            tmp._overwriting = _overwriting;
+            tmp._evictions = _evictions;
+            const size_type n1 = first_span_size();
+            for (pointer p = _array+_first, last = p+n1; p != last; ++p) {
+                tmp.emplace_back(std::move_if_noexcept(*p));
+            }
+            for (pointer p = _array, last = p+(_size-n1); p != last; ++p) {
+                tmp.emplace_back(std::move_if_noexcept(*p));
+            }
+            swap(tmp);
+        }
+
+        // Number of elements in the span starting at _first.
+        size_type first_span_size() const noexcept {
+            return std::min(_size, _capacity - _first);
+        }
+
+        // Destroy all the elements, but do not update the indices.
+        void destroy_all() noexcept {
+            using kss::util::memory::destroy;
+            const size_type n1 = first_span_size();
+            destroy(_array+_first, _array+_first+n1, _allocator);
+            destroy(_array, _array+(_size-n1), _allocator);
+        }
+
+        // Used by append to pick the bulk copy when the iterators allow it.
+        template <class InputIterator>
+        void append(InputIterator first, InputIterator last, std::input_iterator_tag) {
+            for (; first != last; ++first) {
+                push_back(*first);
+            }
+        }
+
+        template <class ForwardIterator>
+        void append(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+            size_type n = size_type(std::distance(first, last));
+            if (n > _capacity - _size) {
+                if (!_overwriting) {
+                    throw std::length_error("This circular_array does not have room for the new elements.");
+                }
+
+                // Anything that would be evicted by a later element is never added.
+                if (n > _capacity) {
+                    std::advance(first, n - _capacity);
+                    _evictions += (n - _capacity);
+                    n = _capacity;
+                }
+                // These are not restored if constructing the new elements fails.
+                const size_type excess = n - (_capacity - _size);
+                for (size_type i = 0; i < excess; ++i) {
+                    pop_front();
+                }
+                _evictions += excess;
+            }
+
+            const size_type n1 = std::min(n, _capacity - _last);
+            ForwardIterator mid = first;
+            std::advance(mid, n1);
+            construct_span(first, mid, _array+_last);
+            try {
+                construct_span(mid, last, _array);
+            }
+            catch (...) {
+                using kss::util::memory::destroy;
+                destroy(_array+_last, _array+_last+n1, _allocator);
+                throw;
+            }
+            _last = CapacityPolicy::wrap(_last + n, _capacity);
+            _size += n;
+        }
+
+        // Construct copies of [first,last) in the uninitialized memory at dest. If an
+        // exception is thrown, anything already constructed is destroyed.
+        template <class ForwardIterator>
+        void construct_span(ForwardIterator first, ForwardIterator last, pointer dest) {
+            using is_bitwise = std::integral_constant<bool,
+                std::is_trivially_copyable<T>::value && std::is_same<A, std::allocator<T>>::value>;
+            construct_span(first, last, dest, is_bitwise());
+        }
+
+        template <class ForwardIterator>
+        void construct_span(ForwardIterator first, ForwardIterator last, pointer dest, std::true_type) {
+            std::uninitialized_copy(first, last, dest);
+        }
+
+        template <class ForwardIterator>
+        void construct_span(ForwardIterator first, ForwardIterator last, pointer dest, std::false_type) {
+            pointer p = dest;
+            try {
+                for (; first != last; ++first, ++p) {
+                    _allocator.construct(p, *first);
+                }
+            }
+            catch (...) {
+                using kss::util::memory::destroy;
+                destroy(dest, p, _allocator);
+                throw;
+            }
+        }
+
+        // Construct an element in the free slot following the back, or preceding the
+        // front, of the array. There must be room for it.
+        template <class... Args>
+        void construct_back(Args&&... args) {
+            _allocator.construct(_array+_last, std::forward<Args>(args)...);
+            _last = CapacityPolicy::wrap(_last + 1, _capacity);
+            ++_size;
+        }
+
+        template <class... Args>
+        void construct_front(Args&&... args) {
+            const size_type pos = CapacityPolicy::wrap(_first + _capacity - 1, _capacity);
+            _allocator.construct(_array+pos, std::forward<Args>(args)...);
+            _first = pos;
+            ++_size;
+        }
+
+        // In overwriting mode we never grow, push_back will evict instead.
         void ensure_room_for_one_more() {
+            if (_overwriting) {
+                return;
+            }
             if (size() == capacity()) {
                 size_type growth = std::max(size_type(10), capacity() / 4);
                 reserve(capacity() + growth);
@@ -671,13 +964,15 @@ namespace kss { namespace util { namespace containers {
         size_type       _last;      // one past last element
         size_type       _size;
         allocator_type  _allocator;
+        bool            _overwriting = false;
+        size_type       _evictions = 0;
     };
 
     /*!
      Swap the contents of two arrays.
      */
-    template <class T, class A>
-    void swap(CircularArray<T,A>& x, CircularArray<T,A>& y) {
+    template <class T, class A, class CP>
+    void swap(CircularArray<T,A,CP>& x, CircularArray<T,A,CP>& y) {
         x.swap(y);
     }
 }}}
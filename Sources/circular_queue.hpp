@@ -0,0 +1,564 @@
+//
+//  circular_queue.hpp
+//  kssutil
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+
+/*!
+ \file
+ \brief Bounded, lock-free queues built on a circular array layout.
+ */
+
+#ifndef kssutil_circular_queue_hpp
+#define kssutil_circular_queue_hpp
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <kss/contract/all.h>
+
+namespace kss { namespace util { namespace containers {
+
+    /*!
+     The assumed size of a cache line. Items that are written by different threads
+     are separated by at least this much padding so that they do not share a cache
+     line. (Padding is used rather than alignas since C++14 does not guarantee that
+     over-aligned types will be honoured by operator new.)
+     */
+    constexpr std::size_t cacheLineSize = 64;
+
+    /*!
+     \brief Lock-free single-producer/single-consumer bounded queue.
+
+     This class uses the same fixed-capacity storage as CircularArray, a single
+     allocation that is never resized, but allows one thread to push elements while
+     a second thread pops them without the need for a mutex. The head and tail
+     positions are stored in separate cache lines, and each side keeps a cached copy
+     of the other side's position so that it only needs to read the shared value
+     when the queue appears full (for the producer) or empty (for the consumer).
+
+     The batch operations try_push_n() and try_pop_n() transfer as many elements as
+     are available, or as will fit, while only publishing the new position once.
+
+     Note that the results are undefined if more than one thread pushes, or more than
+     one thread pops, at the same time. Use MpmcCircularQueue for that situation.
+     In addition size() and empty() are only approximations while the queue is being
+     modified by another thread.
+
+     The method efficiencies are described below:
+
+     - try_push, try_pop - O(1)
+     - try_push_n, try_pop_n - O(n)
+     */
+    template <class T, class A = std::allocator<T>>
+    class SpscCircularQueue {
+    public:
+        using value_type = T;
+        using allocator_type = A;
+        using size_type = typename A::size_type;
+        using pointer = typename A::pointer;
+        using reference = typename A::reference;
+        using const_reference = typename A::const_reference;
+
+        /*!
+         Construct a queue that can hold up to cap elements.
+         @throws std::invalid_argument if cap is 0
+         @throws std::bad_alloc if the memory cannot be allocated
+         */
+        explicit SpscCircularQueue(size_type cap = size_type(10), const A& allocator = A())
+        : _allocator(allocator)
+        {
+            kss::contract::parameters({
+                KSS_EXPR(cap > 0)
+            });
+
+            _slots = cap + 1;
+            _array = _allocator.allocate(_slots);
+
+            kss::contract::postconditions({
+                KSS_EXPR(_array != nullptr),
+                KSS_EXPR(capacity() == cap),
+                KSS_EXPR(empty())
+            });
+        }
+
+        SpscCircularQueue(const SpscCircularQueue&) = delete;
+        SpscCircularQueue& operator=(const SpscCircularQueue&) = delete;
+
+        ~SpscCircularQueue() noexcept {
+            size_type head = _head.load(std::memory_order_relaxed);
+            const size_type tail = _tail.load(std::memory_order_relaxed);
+            while (head != tail) {
+                _allocator.destroy(_array+head);
+                head = next(head);
+            }
+            _allocator.deallocate(_array, _slots);
+        }
+
+        /*!
+         Capacity. Note that size() and empty() are only accurate if they are called
+         from the producer or consumer thread, and even then may be out of date by the
+         time they return.
+         */
+        size_type capacity() const noexcept { return _slots - 1; }
+        bool empty() const noexcept         { return (size() == 0); }
+        size_type size() const noexcept {
+            const size_type tail = _tail.load(std::memory_order_acquire);
+            const size_type head = _head.load(std::memory_order_acquire);
+            return (tail >= head ? tail - head : tail + _slots - head);
+        }
+
+        /*!
+         Producer operations. These will attempt to add an element to the end of the
+         queue. If the queue is full they will return false and the queue will not be
+         modified.
+         @throws any exception that the value_type constructor may throw
+         */
+        bool try_push(const value_type& val) {
+            return try_emplace(val);
+        }
+
+        bool try_push(value_type&& val) {
+            return try_emplace(std::move(val));
+        }
+
+        template <class... Args>
+        bool try_emplace(Args&&... args) {
+            const size_type tail = _tail.load(std::memory_order_relaxed);
+            const size_type nextTail = next(tail);
+            if (nextTail == _cachedHead) {
+                _cachedHead = _head.load(std::memory_order_acquire);
+                if (nextTail == _cachedHead) {
+                    return false;
+                }
+            }
+
+            _allocator.construct(_array+tail, std::forward<Args>(args)...);
+            _tail.store(nextTail, std::memory_order_release);
+            return true;
+        }
+
+        /*!
+         Batch producer operation. This will add up to n elements, starting at first,
+         to the end of the queue. The new elements only become visible to the consumer
+         once they have all been constructed.
+         @return the number of elements actually added.
+         @throws any exception that the value_type constructor may throw
+         */
+        template <class InputIterator>
+        size_type try_push_n(InputIterator first, size_type n) {
+            const size_type tail = _tail.load(std::memory_order_relaxed);
+            size_type room = available(tail, _cachedHead);
+            if (room < n) {
+                _cachedHead = _head.load(std::memory_order_acquire);
+                room = available(tail, _cachedHead);
+            }
+            n = std::min(n, room);
+
+            size_type pos = tail;
+            try {
+                for (size_type i = 0; i < n; ++i, ++first) {
+                    _allocator.construct(_array+pos, *first);
+                    pos = next(pos);
+                }
+            }
+            catch (...) {
+                // Nothing has been published yet, so undo what we have constructed.
+                for (size_type p = tail; p != pos; p = next(p)) {
+                    _allocator.destroy(_array+p);
+                }
+                throw;
+            }
+            if (n > 0) {
+                _tail.store(pos, std::memory_order_release);
+            }
+            return n;
+        }
+
+        /*!
+         Consumer operation. This will attempt to remove the element from the front
+         of the queue, moving it into val. If the queue is empty it will return false
+         and val will not be modified.
+         @throws any exception that the value_type move assignment may throw
+         */
+        bool try_pop(value_type& val) {
+            const size_type head = _head.load(std::memory_order_relaxed);
+            if (head == _cachedTail) {
+                _cachedTail = _tail.load(std::memory_order_acquire);
+                if (head == _cachedTail) {
+                    return false;
+                }
+            }
+
+            val = std::move(_array[head]);
+            _allocator.destroy(_array+head);
+            _head.store(next(head), std::memory_order_release);
+            return true;
+        }
+
+        /*!
+         Batch consumer operation. This will remove up to n elements from the front
+         of the queue, moving them into out. The space is only returned to the
+         producer once all of the elements have been moved.
+         @return the number of elements actually removed.
+         @throws any exception that the value_type move assignment may throw
+         */
+        template <class OutputIterator>
+        size_type try_pop_n(OutputIterator out, size_type n) {
+            const size_type head = _head.load(std::memory_order_relaxed);
+            size_type count = used(head, _cachedTail);
+            if (count < n) {
+                _cachedTail = _tail.load(std::memory_order_acquire);
+                count = used(head, _cachedTail);
+            }
+            n = std::min(n, count);
+
+            size_type pos = head;
+            for (size_type i = 0; i < n; ++i, ++out) {
+                *out = std::move(_array[pos]);
+                _allocator.destroy(_array+pos);
+                pos = next(pos);
+            }
+            if (n > 0) {
+                _head.store(pos, std::memory_order_release);
+            }
+            return n;
+        }
+
+        /*!
+         Return a copy of this container's allocator.
+         */
+        allocator_type get_allocator() const noexcept { return _allocator; }
+
+    private:
+        // One more slot than the capacity is allocated so that a full queue can be
+        // distinguished from an empty one without sharing a counter between threads.
+        inline size_type next(size_type pos) const noexcept {
+            return (++pos == _slots ? 0 : pos);
+        }
+
+        inline size_type used(size_type head, size_type tail) const noexcept {
+            return (tail >= head ? tail - head : tail + _slots - head);
+        }
+
+        inline size_type available(size_type tail, size_type head) const noexcept {
+            return capacity() - used(head, tail);
+        }
+
+        // Read-only after construction, hence safe to share a cache line.
+        pointer         _array = nullptr;
+        size_type       _slots = 0;
+        allocator_type  _allocator;
+
+        // Written only by the consumer.
+        char                    _pad0[cacheLineSize];
+        std::atomic<size_type>  _head { 0 };
+        size_type               _cachedTail = 0;
+
+        // Written only by the producer.
+        char                    _pad1[cacheLineSize];
+        std::atomic<size_type>  _tail { 0 };
+        size_type               _cachedHead = 0;
+        char                    _pad2[cacheLineSize];
+    };
+
+
+    /*!
+     \brief Lock-free multi-producer/multi-consumer bounded queue.
+
+     This class provides a bounded queue that any number of threads may push to and
+     pop from at the same time. Like CircularArray it allocates a fixed number of
+     elements, using the given allocator, when it is constructed and never
+     reallocates. Each slot carries a sequence number that tells a producer when the
+     slot is free to be written and a consumer when it is ready to be read, so the
+     only shared writes are a compare-and-swap on the head or the tail position.
+     (This is the bounded queue described by Dmitry Vyukov.)
+
+     The try_push() and try_pop() methods never block. The push() and pop() methods
+     will spin briefly and then sleep until the operation can be completed. Sleeping
+     threads are counted so that the non-blocking fast path only has to touch the
+     mutex and condition variables when somebody is actually waiting.
+
+     Since a slot cannot be returned to the queue once it has been claimed, the
+     value_type must have non-throwing move construction and move assignment.
+
+     The method efficiencies are described below:
+
+     - try_push, try_pop, push, pop - O(1) (not including time spent waiting)
+     */
+    template <class T, class A = std::allocator<T>>
+    class MpmcCircularQueue {
+    public:
+        static_assert(std::is_nothrow_move_constructible<T>::value,
+                      "MpmcCircularQueue requires a nothrow move constructor");
+        static_assert(std::is_nothrow_move_assignable<T>::value,
+                      "MpmcCircularQueue requires a nothrow move assignment");
+
+        using value_type = T;
+        using allocator_type = A;
+        using size_type = typename A::size_type;
+        using pointer = typename A::pointer;
+        using reference = typename A::reference;
+        using const_reference = typename A::const_reference;
+
+        /*!
+         Construct a queue that can hold up to cap elements. The capacity must be at
+         least 2, since with a single slot the sequence number marking it full would be
+         the same as the one marking it free for the next producer.
+         @throws std::invalid_argument if cap is less than 2
+         @throws std::bad_alloc if the memory cannot be allocated
+         */
+        explicit MpmcCircularQueue(size_type cap = size_type(10), const A& allocator = A())
+        : _allocator(allocator), _slotAllocator(allocator)
+        {
+            kss::contract::parameters({
+                KSS_EXPR(cap >= 2)
+            });
+
+            _capacity = cap;
+            _slots = _slotAllocator.allocate(cap);
+            for (size_type i = 0; i < cap; ++i) {
+                _slotAllocator.construct(_slots+i);
+                _slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+
+            kss::contract::postconditions({
+                KSS_EXPR(_slots != nullptr),
+                KSS_EXPR(capacity() == cap),
+                KSS_EXPR(empty())
+            });
+        }
+
+        MpmcCircularQueue(const MpmcCircularQueue&) = delete;
+        MpmcCircularQueue& operator=(const MpmcCircularQueue&) = delete;
+
+        ~MpmcCircularQueue() noexcept {
+            const size_type tail = _tail.load(std::memory_order_relaxed);
+            for (size_type pos = _head.load(std::memory_order_relaxed); pos != tail; ++pos) {
+                _allocator.destroy(element(slot(pos)));
+            }
+            for (size_type i = 0; i < _capacity; ++i) {
+                _slotAllocator.destroy(_slots+i);
+            }
+            _slotAllocator.deallocate(_slots, _capacity);
+        }
+
+        /*!
+         Capacity. Note that size() and empty() are only approximations while other
+         threads are modifying the queue.
+         */
+        size_type capacity() const noexcept { return _capacity; }
+        bool empty() const noexcept         { return (size() == 0); }
+        size_type size() const noexcept {
+            const size_type head = _head.load(std::memory_order_acquire);
+            const size_type tail = _tail.load(std::memory_order_acquire);
+            return (tail > head ? std::min(tail - head, _capacity) : 0);
+        }
+
+        /*!
+         Non-blocking producer operations. These will attempt to add an element to the
+         end of the queue. If the queue is full they will return false and the queue will
+         not be modified. Note that the element is constructed before a slot is claimed,
+         so an exception from the value_type constructor leaves the queue unchanged.
+         @throws any exception that the value_type constructor may throw
+         */
+        bool try_push(const value_type& val) {
+            value_type v(val);
+            return try_push(std::move(v));
+        }
+
+        bool try_push(value_type&& val) {
+            size_type pos = 0;
+            Slot* s = claim(_tail, 0, pos);
+            if (!s) {
+                return false;
+            }
+            _allocator.construct(element(*s), std::move(val));
+            publish(*s, pos + 1, _consumersWaiting, _notEmpty);
+            return true;
+        }
+
+        template <class... Args>
+        bool try_emplace(Args&&... args) {
+            return try_push(value_type(std::forward<Args>(args)...));
+        }
+
+        /*!
+         Non-blocking consumer operation. This will attempt to remove the element from
+         the front of the queue, moving it into val. If the queue is empty it will
+         return false and val will not be modified.
+         */
+        bool try_pop(value_type& val) noexcept {
+            size_type pos = 0;
+            Slot* s = claim(_head, 1, pos);
+            if (!s) {
+                return false;
+            }
+            pointer p = element(*s);
+            val = std::move(*p);
+            _allocator.destroy(p);
+            publish(*s, pos + _capacity, _producersWaiting, _notFull);
+            return true;
+        }
+
+        /*!
+         Blocking operations. These are the same as their try_ counterparts except that
+         instead of returning false they will wait until there is room in the queue
+         (push) or there is an item in the queue (pop).
+         @throws any exception that the value_type constructor may throw
+         @throws std::system_error if the underlying mutex cannot be locked
+         */
+        void push(const value_type& val) {
+            value_type v(val);
+            push(std::move(v));
+        }
+
+        void push(value_type&& val) {
+            if (!spin([&] { return try_push(std::move(val)); })) {
+                wait(_producersWaiting, _notFull, _tail, 0, [&] { return try_push(std::move(val)); });
+            }
+        }
+
+        void pop(value_type& val) {
+            if (!spin([&] { return try_pop(val); })) {
+                wait(_consumersWaiting, _notEmpty, _head, 1, [&] { return try_pop(val); });
+            }
+        }
+
+        /*!
+         Return a copy of this container's allocator.
+         */
+        allocator_type get_allocator() const noexcept { return _allocator; }
+
+    private:
+        struct Slot {
+            std::atomic<size_type> sequence;
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+        };
+        using slot_allocator_type = typename std::allocator_traits<A>::template rebind_alloc<Slot>;
+        using slot_pointer = typename std::allocator_traits<slot_allocator_type>::pointer;
+
+        static constexpr unsigned spinCount = 64;
+
+        inline Slot& slot(size_type pos) noexcept {
+            return _slots[pos % _capacity];
+        }
+
+        static inline pointer element(Slot& s) noexcept {
+            return reinterpret_cast<pointer>(&s.storage);
+        }
+
+        // Claim the slot at the given position (the tail for producers, the head for
+        // consumers). A slot is ready for a producer when its sequence equals the
+        // position, and for a consumer when it equals the position plus one. If the
+        // sequence is behind that the queue is full (or empty) and nullptr is returned.
+        Slot* claim(std::atomic<size_type>& position, size_type offset, size_type& pos) noexcept {
+            pos = position.load(std::memory_order_relaxed);
+            for (;;) {
+                Slot& s = slot(pos);
+                const size_type seq = s.sequence.load(std::memory_order_acquire);
+                const auto diff = std::ptrdiff_t(seq - (pos + offset));
+                if (diff == 0) {
+                    if (position.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        return &s;
+                    }
+                }
+                else if (diff < 0) {
+                    return nullptr;
+                }
+                else {
+                    pos = position.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Returns true if claim() would not report the queue as full (or empty), i.e.
+        // if it is worth trying again.
+        bool ready(const std::atomic<size_type>& position, size_type offset) noexcept {
+            const size_type pos = position.load(std::memory_order_relaxed);
+            const size_type seq = slot(pos).sequence.load(std::memory_order_acquire);
+            return (std::ptrdiff_t(seq - (pos + offset)) >= 0);
+        }
+
+        // Hand the slot over to the other side and wake one of them if any are sleeping.
+        // The fence pairs with the one in wait() so that either the waiter sees the
+        // change or we see the waiter.
+        void publish(Slot& s,
+                     size_type sequence,
+                     std::atomic<unsigned>& waiting,
+                     std::condition_variable& cv) noexcept
+        {
+            s.sequence.store(sequence, std::memory_order_release);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiting.load(std::memory_order_relaxed) > 0) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                cv.notify_one();
+            }
+        }
+
+        template <class Fn>
+        static bool spin(Fn fn) {
+            for (unsigned i = 0; i < spinCount; ++i) {
+                if (fn()) {
+                    return true;
+                }
+                std::this_thread::yield();
+            }
+            return false;
+        }
+
+        // Keep trying fn until it succeeds, sleeping on cv in between. fn must be called
+        // without the lock held, since a successful call reaches publish(), which may
+        // need to take it. The lock is only held while registering as a waiter and
+        // checking, with ready(), that the queue has not changed in the meantime.
+        template <class Fn>
+        void wait(std::atomic<unsigned>& waiting,
+                  std::condition_variable& cv,
+                  const std::atomic<size_type>& position,
+                  size_type offset,
+                  Fn fn)
+        {
+            while (!fn()) {
+                std::unique_lock<std::mutex> lock(_mutex);
+                waiting.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (!ready(position, offset)) {
+                    cv.wait(lock);
+                }
+                waiting.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+        // Read-only after construction, hence safe to share a cache line.
+        slot_pointer            _slots = nullptr;
+        size_type               _capacity = 0;
+        allocator_type          _allocator;
+        slot_allocator_type     _slotAllocator;
+
+        char                    _pad0[cacheLineSize];
+        std::atomic<size_type>  _head { 0 };
+        char                    _pad1[cacheLineSize];
+        std::atomic<size_type>  _tail { 0 };
+        char                    _pad2[cacheLineSize];
+
+        // Only touched when a thread needs to sleep.
+        std::mutex              _mutex;
+        std::condition_variable _notEmpty;
+        std::condition_variable _notFull;
+        std::atomic<unsigned>   _consumersWaiting { 0 };
+        std::atomic<unsigned>   _producersWaiting { 0 };
+    };
+
+}}}
+
+#endif
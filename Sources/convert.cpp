@@ -11,9 +11,19 @@
 //
 
 #include <cassert>
+#include <cmath>
+#include <clocale>
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
-#include <functional>
+#include <cstring>
 #include <limits>
+#include <type_traits>
+#include <vector>
+
+#if defined(__APPLE__)
+#   include <xlocale.h>
+#endif
 
 #include "convert.hpp"
 #include "stringutil.hpp"
@@ -28,98 +38,432 @@ namespace contract = kss::contract;
 
 // MARK: Simple type overrides
 
+// The arithmetic conversions are implemented in terms of character ranges. They
+// accept the same text as strtol(s, nullptr, 0) and strtod, i.e. leading
+// whitespace, an optional sign, and for the integers an optional "0x" or "0"
+// prefix selecting base 16 or 8. Anything following the number is ignored.
+//
+// The integers are parsed directly, eight decimal digits at a time where possible.
+// Floating point values in the common form of at
+// most 19 significant decimal digits and a small exponent are computed exactly from
+// an integer mantissa and an exact power of ten (Clinger's fast path). Anything else
+// (more digits, large exponents, hex floats, inf, nan) is passed to strtod_l with
+// the "C" locale, copied to a stack buffer when it fits.
+
 namespace {
     template <class T>
-    void throwException(int error, const string& s) {
+    void throwException(int error, const char* first, const char* last) {
         const auto typeName = kss::util::rtti::name<T>();
         throw system_error(error, system_category(),
-                           "Could not convert '" + s + "' to " + typeName);
+                           "Could not convert '" + string(first, last) + "' to " + typeName);
     }
 
     template <class T>
-    T doConvert(const string& s, function<T(const char* sptr, char** endptr)> fn) {
-        contract::parameters({
-            KSS_EXPR(!s.empty())
-        });
+    void throwException(int error, const string& s) {
+        throwException<T>(error, s.data(), s.data() + s.size());
+    }
+
+    inline bool isSpace(char ch) noexcept {
+        return (ch == ' ' || (ch >= '\t' && ch <= '\r'));
+    }
+
+    inline const char* skipSpace(const char* p, const char* last) noexcept {
+        while (p < last && isSpace(*p)) {
+            ++p;
+        }
+        return p;
+    }
+
+    // Returns the value of a digit in bases up to 16, or 16 if ch is not a digit.
+    inline unsigned digitValue(char ch) noexcept {
+        if (ch >= '0' && ch <= '9') { return unsigned(ch - '0'); }
+        if (ch >= 'a' && ch <= 'f') { return unsigned(ch - 'a' + 10); }
+        if (ch >= 'A' && ch <= 'F') { return unsigned(ch - 'A' + 10); }
+        return 16;
+    }
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    // Eight decimal digits at a time using SWAR (SIMD within a register). These
+    // rely on the first character being in the low order byte.
+    inline bool loadEightDigits(const char* p, uint64_t& v) noexcept {
+        memcpy(&v, p, sizeof(v));
+        return ((v & 0xF0F0F0F0F0F0F0F0) | (((v + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4))
+            == 0x3333333333333333;
+    }
+
+    inline uint32_t parseEightDigits(uint64_t v) noexcept {
+        v -= 0x3030303030303030;
+        v = (v * 10) + (v >> 8);
+        v = (((v & 0x000000FF000000FF) * (100 + (1000000ULL << 32)))
+             + (((v >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32)))) >> 32;
+        return uint32_t(v);
+    }
+#   define KSS_SWAR_DIGITS 1
+#endif
+
+    // Parse an integer, returning 0 on success or EINVAL or ERANGE on failure.
+    template <class T>
+    int parseInteger(const char* first, const char* last, T& result) noexcept {
+        using U = typename make_unsigned<T>::type;
+
+        const char* p = skipSpace(first, last);
+        bool negative = false;
+        if (p < last && (*p == '-' || *p == '+')) {
+            negative = (*p == '-');
+            ++p;
+        }
+        if (negative && is_unsigned<T>::value) {
+            return EINVAL;
+        }
+
+        unsigned base = 10;
+        if (p < last && *p == '0') {
+            if ((last - p) > 2 && (p[1] == 'x' || p[1] == 'X') && digitValue(p[2]) < 16) {
+                base = 16;
+                p += 2;
+            }
+            else {
+                base = 8;
+            }
+        }
+
+        const U limit = (negative ? U(U(numeric_limits<T>::max()) + 1) : U(numeric_limits<T>::max()));
+        const char* digits = p;
+        U value = 0;
+
+#if defined(KSS_SWAR_DIGITS)
+        // Take runs of eight decimal digits at once while they cannot overflow. The
+        // remaining digits, and any overflow, are handled by the loop below.
+        if (base == 10 && sizeof(U) >= sizeof(uint32_t)) {
+            uint64_t v = 0;
+            while ((last - p) >= 8 && loadEightDigits(p, v)) {
+                const uint32_t chunk = parseEightDigits(v);
+                if (value > (limit - chunk) / 100000000U) {
+                    break;
+                }
+                value = U(value * 100000000U + chunk);
+                p += 8;
+            }
+        }
+#endif
+
+        bool overflow = false;
+        for (; p < last; ++p) {
+            const unsigned d = digitValue(*p);
+            if (d >= base) {
+                break;
+            }
+            if (value > (limit - d) / base) {
+                overflow = true;
+            }
+            else {
+                value = U(value * base + d);
+            }
+        }
+
+        if (p == digits) { return EINVAL; }
+        if (overflow) { return ERANGE; }
+        result = (negative ? T(-T(value - 1) - 1) : T(value));
+        return 0;
+    }
+
+    // Floating point properties needed for the fast path. The mantissa must be
+    // exactly representable, as must each power of ten up to maxExponent.
+    template <class T> struct FastPathLimits;
+
+    template <> struct FastPathLimits<float> {
+        static constexpr uint64_t maxMantissa = uint64_t(1) << 24;
+        static constexpr int maxExponent = 10;
+    };
+
+    template <> struct FastPathLimits<double> {
+        static constexpr uint64_t maxMantissa = uint64_t(1) << 53;
+        static constexpr int maxExponent = 22;
+    };
+
+    constexpr double exactPowersOfTen[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    // Attempt the fast path. Returns false if the text needs the full conversion.
+    template <class T>
+    bool fastParseFloat(const char* first, const char* last, T& value) noexcept {
+        const char* p = skipSpace(first, last);
+        bool negative = false;
+        if (p < last && (*p == '-' || *p == '+')) {
+            negative = (*p == '-');
+            ++p;
+        }
+
+        uint64_t mantissa = 0;
+        int numDigits = 0;          // significant digits in the mantissa
+        int exponent = 0;
+        bool anyDigits = false;
+        for (; p < last && *p >= '0' && *p <= '9'; ++p) {
+            anyDigits = true;
+            if (mantissa != 0 || *p != '0') {
+                mantissa = mantissa * 10 + unsigned(*p - '0');
+                ++numDigits;
+            }
+        }
+        if (p < last && (*p == 'x' || *p == 'X')) {
+            return false;       // hexadecimal
+        }
+        if (p < last && *p == '.') {
+            for (++p; p < last && *p >= '0' && *p <= '9'; ++p) {
+                anyDigits = true;
+                if (mantissa != 0 || *p != '0') {
+                    mantissa = mantissa * 10 + unsigned(*p - '0');
+                    ++numDigits;
+                }
+                --exponent;
+            }
+        }
+        if (!anyDigits || numDigits > 19) {
+            return false;
+        }
+
+        if (p < last && (*p == 'e' || *p == 'E')) {
+            const char* q = p + 1;
+            bool negativeExponent = false;
+            if (q < last && (*q == '-' || *q == '+')) {
+                negativeExponent = (*q == '-');
+                ++q;
+            }
+            if (q < last && *q >= '0' && *q <= '9') {
+                int e = 0;
+                for (; q < last && *q >= '0' && *q <= '9'; ++q) {
+                    if (e > 1000) {
+                        return false;
+                    }
+                    e = e * 10 + (*q - '0');
+                }
+                exponent += (negativeExponent ? -e : e);
+            }
+        }
+
+        if (mantissa > FastPathLimits<T>::maxMantissa
+            || exponent < -FastPathLimits<T>::maxExponent
+            || exponent > FastPathLimits<T>::maxExponent)
+        {
+            return false;
+        }
+
+        value = T(mantissa);
+        if (exponent < 0) {
+            value /= T(exactPowersOfTen[-exponent]);
+        }
+        else {
+            value *= T(exactPowersOfTen[exponent]);
+        }
+        if (negative) {
+            value = -value;
+        }
+        return true;
+    }
+
+    locale_t cLocale() {
+        static const locale_t loc = newlocale(LC_ALL_MASK, "C", locale_t(0));
+        return loc;
+    }
+
+    // Parse using fn, returning 0 on success or the error number on failure. This
+    // may allocate memory, but only if the string does not fit the stack buffer.
+    template <class T>
+    int slowParseFloat(const char* first, const char* last, T& result,
+                       T (*fn)(const char*, char**, locale_t))
+    {
+        constexpr size_t bufferSize = 128;
+        char buffer[bufferSize];
+        string longBuffer;
+        const size_t len = size_t(last - first);
+        const char* s = buffer;
+        if (len < bufferSize) {
+            memcpy(buffer, first, len);
+            buffer[len] = '\0';
+        }
+        else {
+            longBuffer.assign(first, last);
+            s = longBuffer.c_str();
+        }
 
         errno = 0;
         char* endptr = nullptr;
-        const T t = fn(s.c_str(), &endptr);
+        const T t = fn(s, &endptr, cLocale());
+
+        if (!errno && (s == endptr)) { return EINVAL; }
+        if (errno) { return errno; }
+        result = t;
+        return 0;
+    }
+
+    // The non-throwing parse of each arithmetic type. There is no fast path for
+    // long double since the result of the double arithmetic is not necessarily the
+    // closest long double.
+    template <class T>
+    int parse(const char* first, const char* last, T& result) {
+        return parseInteger(first, last, result);
+    }
 
-        if (!errno && (s.c_str() == endptr)) { throwException<T>(EINVAL, s); }
-        if (errno) { throwException<T>(errno, s); }
+    template <>
+    int parse(const char* first, const char* last, float& result) {
+        return (fastParseFloat(first, last, result) ? 0 : slowParseFloat(first, last, result, strtof_l));
+    }
 
-        return t;
+    template <>
+    int parse(const char* first, const char* last, double& result) {
+        return (fastParseFloat(first, last, result) ? 0 : slowParseFloat(first, last, result, strtod_l));
+    }
+
+    template <>
+    int parse(const char* first, const char* last, long double& result) {
+        return slowParseFloat(first, last, result, strtold_l);
     }
 
     template <class T>
-    T doConvertInt(const string& s, function<T(const char*, char**, int)> fn) {
-        return doConvert<T>(s, [&](const char* sptr, char** endptr) {
-            return fn(sptr, endptr, 0);
+    T checkedParse(const char* first, const char* last) {
+        contract::parameters({
+            KSS_EXPR(first != nullptr),
+            KSS_EXPR(first < last)
         });
+
+        T result = T();
+        const int err = parse(first, last, result);
+        if (err) {
+            throwException<T>(err, first, last);
+        }
+        return result;
     }
+}
 
-    template <class T>
-    T doConvertUnsigned(const string& s, function<T(const char*, char**, int)> fn) {
-        const auto pos = s.find_first_not_of("\t\n\v\f\r ");
-        if (pos != string::npos && s[pos] == '-') {
-            throwException<T>(EINVAL, s);
+template<>
+float kss::util::strings::convert(const char* first, const char* last) {
+    return checkedParse<float>(first, last);
+}
+
+template<>
+double kss::util::strings::convert(const char* first, const char* last) {
+    return checkedParse<double>(first, last);
+}
+
+template<>
+long double kss::util::strings::convert(const char* first, const char* last) {
+    return checkedParse<long double>(first, last);
+}
+
+template<>
+int kss::util::strings::convert(const char* first, const char* last) {
+    return checkedParse<int>(first, last);
+}
+
+template<>
+long kss::util::strings::convert(const char* first, const char* last) {
+    return checkedParse<long>(first, last);
+}
+
+template<>
+long long kss::util::strings::convert(const char* first, const char* last) {
+    return checkedParse<long long>(first, last);
+}
+
+template<>
+unsigned kss::util::strings::convert(const char* first, const char* last) {
+    return checkedParse<unsigned>(first, last);
+}
+
+template<>
+unsigned long kss::util::strings::convert(const char* first, const char* last) {
+    return checkedParse<unsigned long>(first, last);
+}
+
+template<>
+unsigned long long kss::util::strings::convert(const char* first, const char* last) {
+    return checkedParse<unsigned long long>(first, last);
+}
+
+
+// MARK: Batch conversion
+
+template <class T>
+size_t kss::util::strings::convertAll(const stringview_t* input, size_t n, T* output,
+                                      vector<size_t>* errors)
+{
+    contract::parameters({
+        KSS_EXPR(n == 0 || input != nullptr),
+        KSS_EXPR(n == 0 || output != nullptr)
+    });
+
+    size_t numErrors = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const stringview_t s = input[i];
+        T result = T();
+        if (s.empty() || parse(s.data(), s.data() + s.size(), result) != 0) {
+            result = T();
+            ++numErrors;
+            if (errors) {
+                errors->push_back(i);
+            }
         }
-        return doConvertInt<T>(s, fn);
+        output[i] = result;
     }
+    return numErrors;
 }
 
+template size_t kss::util::strings::convertAll(const stringview_t*, size_t, float*, vector<size_t>*);
+template size_t kss::util::strings::convertAll(const stringview_t*, size_t, double*, vector<size_t>*);
+template size_t kss::util::strings::convertAll(const stringview_t*, size_t, long double*, vector<size_t>*);
+template size_t kss::util::strings::convertAll(const stringview_t*, size_t, int*, vector<size_t>*);
+template size_t kss::util::strings::convertAll(const stringview_t*, size_t, long*, vector<size_t>*);
+template size_t kss::util::strings::convertAll(const stringview_t*, size_t, long long*, vector<size_t>*);
+template size_t kss::util::strings::convertAll(const stringview_t*, size_t, unsigned*, vector<size_t>*);
+template size_t kss::util::strings::convertAll(const stringview_t*, size_t, unsigned long*, vector<size_t>*);
+template size_t kss::util::strings::convertAll(const stringview_t*, size_t, unsigned long long*, vector<size_t>*);
+
+
 template<>
 float kss::util::strings::convert(const string& s, const float&) {
-    return doConvert<float>(s, strtof);
+    return convert<float>(s.data(), s.data() + s.size());
 }
 
 template<>
 double kss::util::strings::convert(const string& s, const double&) {
-    return doConvert<double>(s, strtod);
+    return convert<double>(s.data(), s.data() + s.size());
 }
 
 template<>
 long double kss::util::strings::convert(const string& s, const long double&) {
-    return doConvert<long double>(s, strtold);
+    return convert<long double>(s.data(), s.data() + s.size());
 }
 
 template<>
 int kss::util::strings::convert(const string& s, const int&) {
-    const auto val = convert<long>(s);
-    if (val < numeric_limits<int>::min() || val > numeric_limits<int>::max()) {
-        throwException<int>(ERANGE, s);
-    }
-    return (int)val;
+    return convert<int>(s.data(), s.data() + s.size());
 }
 
 template<>
 long kss::util::strings::convert(const string& s, const long&) {
-    return doConvertInt<long>(s, strtol);
+    return convert<long>(s.data(), s.data() + s.size());
 }
 
 template<>
 long long kss::util::strings::convert(const string& s, const long long&) {
-    return doConvertInt<long>(s, strtoll);
+    return convert<long long>(s.data(), s.data() + s.size());
 }
 
 template<>
 unsigned kss::util::strings::convert(const string& s, const unsigned&) {
-    const auto val = convert<unsigned long>(s);
-    if (val > numeric_limits<unsigned>::max()) {
-        throwException<unsigned>(ERANGE, s);
-    }
-    return (unsigned)val;
+    return convert<unsigned>(s.data(), s.data() + s.size());
 }
 
 template<>
 unsigned long kss::util::strings::convert(const string& s, const unsigned long&) {
-    return doConvertUnsigned<unsigned long>(s, strtoul);
+    return convert<unsigned long>(s.data(), s.data() + s.size());
 }
 
 template<>
 unsigned long long kss::util::strings::convert(const string& s, const unsigned long long&) {
-    return doConvertUnsigned<unsigned long long>(s, strtoull);
+    return convert<unsigned long long>(s.data(), s.data() + s.size());
 }
 
 // MARK: Duration overrides
@@ -296,3 +640,178 @@ kss::util::strings::convert(const std::string& s,
 {
     return doConvertTimePoint(s, tp);
 }
+
+
+// MARK: Formatting
+
+// Integers are written two digits at a time from a table of digit pairs. Floating
+// point values that %g would write without an exponent, and that are exactly
+// m / 10^k (correctly rounded) for some m of at most digits10 digits, are written
+// directly from m. Parsing such text gives back the same value, since the parse
+// performs exactly that division, and the smallest such k gives the fewest digits.
+// Others are written with snprintf using the fewest digits, from digits10 up to
+// max_digits10, that parse back to the same value, with the "C" locale selected for
+// the calling thread.
+
+namespace {
+    const char digitPairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+    template <class U>
+    char* writeUnsigned(char* first, char* last, U value) noexcept {
+        char buffer[std::numeric_limits<U>::digits10 + 1];
+        char* end = buffer + sizeof(buffer);
+        char* p = end;
+        while (value >= 100) {
+            const size_t i = size_t(value % 100) * 2;
+            value /= 100;
+            p -= 2;
+            memcpy(p, digitPairs + i, 2);
+        }
+        if (value >= 10) {
+            p -= 2;
+            memcpy(p, digitPairs + size_t(value) * 2, 2);
+        }
+        else {
+            *--p = char('0' + value);
+        }
+
+        const size_t len = size_t(end - p);
+        if (size_t(last - first) < len) {
+            return nullptr;
+        }
+        memcpy(first, p, len);
+        return first + len;
+    }
+
+    template <class T>
+    char* writeInteger(char* first, char* last, T value) noexcept {
+        using U = typename make_unsigned<T>::type;
+        if (value < 0) {
+            if (first == last) {
+                return nullptr;
+            }
+            *first++ = '-';
+            return writeUnsigned(first, last, U(U(0) - U(value)));
+        }
+        return writeUnsigned(first, last, U(value));
+    }
+
+    // Selects the "C" locale for the calling thread while in scope.
+    class CLocaleGuard {
+    public:
+        CLocaleGuard() noexcept : _old(uselocale(cLocale())) {}
+        ~CLocaleGuard() noexcept { uselocale(_old); }
+    private:
+        locale_t _old;
+    };
+
+    // Write m / 10^k with exactly k decimal places.
+    char* writeFixed(char* first, char* last, bool negative, unsigned long long m, int k) noexcept {
+        const auto scale = static_cast<unsigned long long>(exactPowersOfTen[k]);
+        if (negative) {
+            if (first == last) {
+                return nullptr;
+            }
+            *first++ = '-';
+        }
+        first = writeUnsigned(first, last, m / scale);
+        if (!first || (last - first) < (k + 1)) {
+            return nullptr;
+        }
+        *first++ = '.';
+        auto frac = m % scale;
+        for (int i = k; i-- > 0; ) {
+            first[i] = char('0' + frac % 10);
+            frac /= 10;
+        }
+        return first + k;
+    }
+
+    template <class T>
+    char* writeFloat(char* first, char* last, T value, const char* fmt) noexcept {
+        constexpr int maxDigits = numeric_limits<T>::digits10;
+        const T limit = T(exactPowersOfTen[maxDigits]);
+        const T absValue = std::fabs(value);
+        if (std::trunc(value) == value && absValue < limit) {
+            if (value == 0 && std::signbit(value)) {
+                if (first == last) {
+                    return nullptr;
+                }
+                *first++ = '-';
+            }
+            return writeInteger(first, last, static_cast<long long>(value));
+        }
+
+        if (absValue >= T(1e-4) && absValue < limit) {
+            for (int k = 1; k <= maxDigits; ++k) {
+                const T scaled = std::round(absValue * T(exactPowersOfTen[k]));
+                if (scaled >= limit) {
+                    break;
+                }
+                if (scaled / T(exactPowersOfTen[k]) == absValue) {
+                    return writeFixed(first, last, std::signbit(value),
+                                      static_cast<unsigned long long>(scaled), k);
+                }
+            }
+        }
+
+        CLocaleGuard guard;
+        char buffer[maxToCharsLength];
+        int len = 0;
+        for (int precision = numeric_limits<T>::digits10; ; ++precision) {
+            len = snprintf(buffer, sizeof(buffer), fmt, precision, value);
+            T check = T();
+            if (!std::isfinite(value)
+                || precision >= numeric_limits<T>::max_digits10
+                || (parse(buffer, buffer + len, check) == 0 && check == value))
+            {
+                break;
+            }
+        }
+
+        if ((last - first) < len) {
+            return nullptr;
+        }
+        memcpy(first, buffer, size_t(len));
+        return first + len;
+    }
+}
+
+char* kss::util::strings::toChars(char* first, char* last, int value) noexcept {
+    return writeInteger(first, last, value);
+}
+
+char* kss::util::strings::toChars(char* first, char* last, long value) noexcept {
+    return writeInteger(first, last, value);
+}
+
+char* kss::util::strings::toChars(char* first, char* last, long long value) noexcept {
+    return writeInteger(first, last, value);
+}
+
+char* kss::util::strings::toChars(char* first, char* last, unsigned value) noexcept {
+    return writeUnsigned(first, last, value);
+}
+
+char* kss::util::strings::toChars(char* first, char* last, unsigned long value) noexcept {
+    return writeUnsigned(first, last, value);
+}
+
+char* kss::util::strings::toChars(char* first, char* last, unsigned long long value) noexcept {
+    return writeUnsigned(first, last, value);
+}
+
+char* kss::util::strings::toChars(char* first, char* last, float value) noexcept {
+    return writeFloat(first, last, value, "%.*g");
+}
+
+char* kss::util::strings::toChars(char* first, char* last, double value) noexcept {
+    return writeFloat(first, last, value, "%.*g");
+}
+
+char* kss::util::strings::toChars(char* first, char* last, long double value) noexcept {
+    return writeFloat(first, last, value, "%.*Lg");
+}
@@ -12,15 +12,18 @@
 
 #include <cerrno>
 #include <chrono>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <string>
 #include <system_error>
 #include <typeinfo>
+#include <vector>
 
 #include <kss/contract/all.h>
 
 #include "rtti.hpp"
+#include "stringview.hpp"
 
 /*!
  \file
@@ -69,6 +72,76 @@ namespace kss { namespace util { namespace strings {
     template<> unsigned long long convert(const std::string& s,
                                           const unsigned long long&);
 
+    /*!
+     Attempt to convert the characters in [first, last) to the type T. For the
+     arithmetic types this accepts the same text, and reports the same errors, as
+     the std::string versions, but does not allocate memory (other than for an
+     exception message) and does not depend on the current locale. For any other
+     type it is equivalent to converting std::string(first, last).
+     @throws std::system_error if the conversion failed.
+     @throws std::invalid_argument if the range is empty
+     */
+    template <class T>
+    T convert(const char* first, const char* last) {
+        return convert<T>(std::string(first, last));
+    }
+
+    template<> float convert(const char* first, const char* last);
+    template<> double convert(const char* first, const char* last);
+    template<> long double convert(const char* first, const char* last);
+    template<> int convert(const char* first, const char* last);
+    template<> long convert(const char* first, const char* last);
+    template<> long long convert(const char* first, const char* last);
+    template<> unsigned convert(const char* first, const char* last);
+    template<> unsigned long convert(const char* first, const char* last);
+    template<> unsigned long long convert(const char* first, const char* last);
+
+    /*!
+     Convenience versions of the range based conversion. The C string version is
+     needed so that a string literal is not ambiguous between the std::string and
+     stringview_t versions.
+     @throws std::system_error if the conversion failed.
+     @throws std::invalid_argument if s is empty
+     */
+    template <class T>
+    T convert(stringview_t s, const T& = T()) {
+        return convert<T>(s.data(), s.data() + s.size());
+    }
+
+    template <class T>
+    T convert(const char* s, const T& = T()) {
+        return convert<T>(stringview_t(s));
+    }
+
+    /*!
+     Convert each of the n strings in input to the type T, placing the results in
+     output, which must have room for n values. Rather than throwing an exception
+     for a string that cannot be converted (including an empty one), its output is
+     set to T() and its index is appended to errors, if errors is not null. Hence
+     dirty data costs no more to convert than clean data.
+
+     This is available for the arithmetic types that have a range based convert.
+
+     @return the number of strings that could not be converted
+     @throws std::invalid_argument if n > 0 and either input or output is null
+     @throws std::bad_alloc if errors could not be extended
+     */
+    template <class T>
+    size_t convertAll(const stringview_t* input, size_t n, T* output,
+                      std::vector<size_t>* errors = nullptr);
+
+    /*!
+     Vector version of convertAll. The output vector is resized to match the input.
+     @throws std::bad_alloc if output or errors could not be extended
+     */
+    template <class T>
+    size_t convertAll(const std::vector<stringview_t>& input, std::vector<T>& output,
+                      std::vector<size_t>* errors = nullptr)
+    {
+        output.resize(input.size());
+        return convertAll<T>(input.data(), input.size(), output.data(), errors);
+    }
+
     // These specializations are used to convert text representations of durations
     // (e.g. "10s") into their corresponding durations (e.g. std::chrono::seconds).
     // Note that while these will convert the duration types, for example,
@@ -134,6 +207,83 @@ namespace kss { namespace util { namespace strings {
     template<>
     std::chrono::time_point<std::chrono::steady_clock, std::chrono::nanoseconds>
     convert(const std::string& s, const std::chrono::time_point<std::chrono::steady_clock, std::chrono::nanoseconds>&);
+
+    // MARK: Formatting
+
+    /*!
+     The largest number of characters written by any of the toChars functions.
+     */
+    constexpr size_t maxToCharsLength = 64;
+
+    /*!
+     Write the text form of value to the buffer [first, last), returning a pointer to
+     one past the last character written, or nullptr if the buffer is too small (in
+     which case its contents are unspecified). No null terminator is written. The
+     text may be converted back using convert.
+
+     Integers are written in decimal. Floating point values are written in the
+     shortest %g style form that converts back to the same value. Neither depends
+     on the current locale.
+     */
+    char* toChars(char* first, char* last, int value) noexcept;
+    char* toChars(char* first, char* last, long value) noexcept;
+    char* toChars(char* first, char* last, long long value) noexcept;
+    char* toChars(char* first, char* last, unsigned value) noexcept;
+    char* toChars(char* first, char* last, unsigned long value) noexcept;
+    char* toChars(char* first, char* last, unsigned long long value) noexcept;
+    char* toChars(char* first, char* last, float value) noexcept;
+    char* toChars(char* first, char* last, double value) noexcept;
+    char* toChars(char* first, char* last, long double value) noexcept;
+
+    namespace _private {
+        template <class Period> struct DurationSuffix;
+        template <> struct DurationSuffix<std::chrono::hours::period> {
+            static constexpr const char* value = "h";
+        };
+        template <> struct DurationSuffix<std::chrono::minutes::period> {
+            static constexpr const char* value = "min";
+        };
+        template <> struct DurationSuffix<std::chrono::seconds::period> {
+            static constexpr const char* value = "s";
+        };
+        template <> struct DurationSuffix<std::chrono::milliseconds::period> {
+            static constexpr const char* value = "ms";
+        };
+        template <> struct DurationSuffix<std::chrono::microseconds::period> {
+            static constexpr const char* value = "us";
+        };
+        template <> struct DurationSuffix<std::chrono::nanoseconds::period> {
+            static constexpr const char* value = "ns";
+        };
+    }
+
+    /*!
+     Write a duration as its count followed by the suffix that convert accepts,
+     e.g. "10ms". This is only available for the standard std::chrono durations.
+     */
+    template <class Rep, class Period>
+    char* toChars(char* first, char* last, const std::chrono::duration<Rep, Period>& dtn) noexcept {
+        const char* suffix = _private::DurationSuffix<Period>::value;
+        const size_t len = std::strlen(suffix);
+        char* p = toChars(first, last, dtn.count());
+        if (!p || size_t(last - p) < len) {
+            return nullptr;
+        }
+        std::memcpy(p, suffix, len);
+        return p + len;
+    }
+
+    /*!
+     Append the text form of value, as written by toChars, to s.
+     @return a reference to s
+     @throws std::bad_alloc if s could not be extended
+     */
+    template <class T>
+    std::string& appendTo(std::string& s, const T& value) {
+        char buffer[maxToCharsLength];
+        const char* p = toChars(buffer, buffer + maxToCharsLength, value);
+        return s.append(buffer, size_t(p - buffer));
+    }
 }}}
 
 #endif
@@ -0,0 +1,126 @@
+//
+//  csvtokenizer.cpp
+//  kssutil
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+
+#include <cstring>
+#include <stdexcept>
+
+#include <kss/contract/all.h>
+
+#include "csvtokenizer.hpp"
+
+using namespace std;
+using namespace kss::util::strings;
+
+namespace contract = kss::contract;
+
+
+CsvTokenizer::CsvTokenizer(stringview_t s, char delim, char quote)
+: _s(s), _unquotedEnd(string { delim, '\n' }), _delim(delim), _quote(quote)
+{
+    contract::parameters({
+        KSS_EXPR(delim != quote),
+        KSS_EXPR(delim != '\n' && delim != '\r'),
+        KSS_EXPR(quote != '\n' && quote != '\r')
+    });
+
+    contract::postconditions({
+        KSS_EXPR(_pos == 0),
+        KSS_EXPR(!_afterDelimiter)
+    });
+}
+
+
+// Obtain the next field. The tokenizer state is only updated once the field has
+// been found, so that it is unchanged if the field is malformed.
+stringview_t& CsvTokenizer::next(stringview_t& token) {
+    contract::preconditions({
+        KSS_EXPR(hasAnother() == true)
+    });
+
+    const char* first = _s.data() + _pos;
+    const char* last = _s.data() + _s.size();
+    const char* p = nullptr;
+    if (first < last && *first == _quote) {
+        p = nextQuoted(first, last, token);
+    }
+    else {
+        // An unquoted field ends at the delimiter or newline, less any '\r' before
+        // the newline.
+        p = _unquotedEnd.find(first, last);
+        const bool crlf = (p != last && *p == '\n' && p > first && *(p-1) == '\r');
+        token = stringview_t(first, size_t(p - first) - (crlf ? 1 : 0));
+    }
+
+    if (p == last) {
+        _afterDelimiter = false;
+        _endOfRecord = true;
+    }
+    else if (*p == _delim) {
+        _afterDelimiter = true;
+        _endOfRecord = false;
+        ++p;
+    }
+    else {
+        _afterDelimiter = false;
+        _endOfRecord = true;
+        p += (*p == '\r' ? 2 : 1);
+    }
+    _pos = size_t(p - _s.data());
+    return token;
+}
+
+// Parse the quoted field starting at first, placing its contents in token and
+// returning a pointer to the character following the closing quote. The field is
+// only copied, into _buf, if it contains doubled quotes. Nothing is modified until
+// the field is known to be valid.
+const char* CsvTokenizer::nextQuoted(const char* first, const char* last, stringview_t& token) {
+    const char* start = first + 1;
+
+    // Find the closing quote, skipping any doubled quotes.
+    const char* q = start;
+    bool escaped = false;
+    while (true) {
+        q = static_cast<const char*>(memchr(q, _quote, size_t(last - q)));
+        if (!q) {
+            throw invalid_argument("Unterminated quoted field at position "
+                                   + to_string(first - _s.data()));
+        }
+        if (q+1 < last && *(q+1) == _quote) {
+            escaped = true;
+            q += 2;
+            continue;
+        }
+        break;
+    }
+
+    const char* p = q + 1;
+    if (p != last && *p != _delim && *p != '\n' && !(*p == '\r' && p+1 < last && *(p+1) == '\n')) {
+        throw invalid_argument("Unexpected character after the quoted field at position "
+                               + to_string(first - _s.data()));
+    }
+
+    if (!escaped) {
+        token = stringview_t(start, size_t(q - start));
+        return p;
+    }
+
+    // Copy the field, keeping only the first quote of each pair.
+    _buf.clear();
+    for (const char* r = start; r < q; ) {
+        const char* d = static_cast<const char*>(memchr(r, _quote, size_t(q - r)));
+        if (!d) {
+            _buf.append(r, size_t(q - r));
+            break;
+        }
+        _buf.append(r, size_t(d+1 - r));
+        r = d + 2;
+    }
+    token = stringview_t(_buf);
+    return p;
+}
@@ -0,0 +1,121 @@
+//
+//  csvtokenizer.hpp
+//  kssutil
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+
+/*!
+ \file
+ \brief Splitting of comma separated values.
+ */
+
+#ifndef kssutil_csvtokenizer_hpp
+#define kssutil_csvtokenizer_hpp
+
+#include <string>
+
+#include "delimiterset.hpp"
+#include "iterator.hpp"
+#include "stringview.hpp"
+
+namespace kss { namespace util { namespace strings {
+
+    /*!
+     \brief Tokenizer for comma separated values.
+
+     This splits a string into fields following RFC 4180. Fields are separated by the
+     delimiter and records by a newline, either "\n" or "\r\n". A field that starts
+     with the quote character continues until the matching quote, and may contain
+     delimiters and newlines, with a doubled quote representing a single quote
+     character. A newline at the end of the input does not start another record.
+
+     Like the ViewTokenizer, this borrows the string and returns each field as a
+     stringview_t referring to the characters of that string. The exception is a field
+     containing doubled quotes, which must be copied in order to remove them. Such a
+     field refers to an internal buffer instead, and is only valid until the next call
+     to next(). Hence memory is only allocated for fields that contain escapes, and
+     even then the buffer is reused.
+
+     Use endOfRecord() after each call to next() to determine if the field was the
+     last of its record.
+     */
+    class CsvTokenizer {
+    public:
+        /*!
+         Container/iterator based type definitions.
+         */
+        using value_type = stringview_t;
+        using iterator = kss::util::iterators::ForwardIterator<CsvTokenizer, stringview_t>;
+
+        /*!
+         Create the tokenizer for a given string. As with the ViewTokenizer, the string
+         may be anything that can be converted to a stringview_t, but not a temporary
+         std::string.
+
+         @param s is the string to be split into fields
+         @param delim is the field delimiter
+         @param quote is the quote character
+         @throws std::invalid_argument if delim and quote are the same, or if either
+            is a newline character
+         */
+        explicit CsvTokenizer(stringview_t s, char delim = ',', char quote = '"');
+        template <class Alloc>
+        explicit CsvTokenizer(std::basic_string<char, std::char_traits<char>, Alloc>&& s,
+                              char delim = ',', char quote = '"') = delete;
+        ~CsvTokenizer() noexcept = default;
+
+        CsvTokenizer(const CsvTokenizer&) = delete;
+        CsvTokenizer& operator=(const CsvTokenizer&) = delete;
+
+        /*!
+         Returns true if there is another field available and false otherwise.
+         */
+        inline bool hasAnother() const noexcept {
+            return (_pos < _s.size() || _afterDelimiter);
+        }
+
+        /*!
+         Retrieves the next field and places it in token. It is invalid to call this
+         if there are no more fields. If the field is malformed the tokenizer and
+         token are left unchanged. If the field could not be copied, the tokenizer
+         and token are also unchanged, but a field previously returned from the
+         internal buffer is no longer valid.
+         @return a reference to token
+         @throws std::invalid_argument if a quoted field is not terminated, or if its
+            closing quote is followed by something other than a delimiter or newline
+         @throws std::bad_alloc if a field with escapes could not be copied
+         */
+        stringview_t& next(stringview_t& token);
+
+        /*!
+         Returns true if the field most recently returned by next() was the last
+         field of its record.
+         */
+        bool endOfRecord() const noexcept { return _endOfRecord; }
+
+        /*!
+         Iterator based access. As with the Tokenizer, you should use either this or
+         the stream based access, but not both.
+         */
+        iterator begin() { return iterator(*this); }
+        iterator end()   { return iterator(); }
+
+    private:
+        stringview_t    _s;
+        DelimiterSet    _unquotedEnd;       // the delimiter and '\n'
+        char            _delim;
+        char            _quote;
+        size_t          _pos = 0;
+        bool            _afterDelimiter = false;    // a field always follows a delimiter
+        bool            _endOfRecord = false;
+        std::string     _buf;                       // unescaped copy of the current field
+
+        const char* nextQuoted(const char* first, const char* last, stringview_t& token);
+    };
+
+}}}
+
+#endif
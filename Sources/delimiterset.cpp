@@ -0,0 +1,97 @@
+//
+//  delimiterset.cpp
+//  kssutil
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+
+#if defined(__AVX2__)
+#   include <immintrin.h>
+#elif defined(__SSE2__)
+#   include <emmintrin.h>
+#endif
+
+#include "delimiterset.hpp"
+
+using namespace std;
+using namespace kss::util::strings;
+
+constexpr size_t DelimiterSet::maxVectorDelimiters;
+
+
+namespace {
+
+    // Each of these returns a pointer to the first delimiter in the blocks of
+    // [first, last), or to the start of the final partial block if there are no
+    // delimiters in the full blocks. The caller must then check the remaining bytes.
+
+#if defined(__AVX2__)
+    const char* findBlocks(const char* first, const char* last, const char* chars, size_t n) noexcept {
+        __m256i needles[DelimiterSet::maxVectorDelimiters];
+        for (size_t i = 0; i < n; ++i) {
+            needles[i] = _mm256_set1_epi8(chars[i]);
+        }
+        for (; last - first >= 32; first += 32) {
+            const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+            __m256i eq = _mm256_cmpeq_epi8(block, needles[0]);
+            for (size_t i = 1; i < n; ++i) {
+                eq = _mm256_or_si256(eq, _mm256_cmpeq_epi8(block, needles[i]));
+            }
+            const unsigned mask = unsigned(_mm256_movemask_epi8(eq));
+            if (mask != 0) {
+                return first + __builtin_ctz(mask);
+            }
+        }
+        return first;
+    }
+#elif defined(__SSE2__)
+    const char* findBlocks(const char* first, const char* last, const char* chars, size_t n) noexcept {
+        __m128i needles[DelimiterSet::maxVectorDelimiters];
+        for (size_t i = 0; i < n; ++i) {
+            needles[i] = _mm_set1_epi8(chars[i]);
+        }
+        for (; last - first >= 16; first += 16) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            __m128i eq = _mm_cmpeq_epi8(block, needles[0]);
+            for (size_t i = 1; i < n; ++i) {
+                eq = _mm_or_si128(eq, _mm_cmpeq_epi8(block, needles[i]));
+            }
+            const unsigned mask = unsigned(_mm_movemask_epi8(eq));
+            if (mask != 0) {
+                return first + __builtin_ctz(mask);
+            }
+        }
+        return first;
+    }
+#endif
+}
+
+
+DelimiterSet::DelimiterSet(stringview_t delims) noexcept : _bits { 0, 0, 0, 0 } {
+    for (char c : delims) {
+        if (!contains(c)) {
+            const auto uc = static_cast<unsigned char>(c);
+            _bits[uc >> 6] |= (uint64_t(1) << (uc & 63));
+            if (_numChars < maxVectorDelimiters) {
+                _chars[_numChars] = c;
+            }
+            ++_numChars;
+        }
+    }
+}
+
+const char* DelimiterSet::find(const char* first, const char* last) const noexcept {
+#if defined(__AVX2__) || defined(__SSE2__)
+    if (_numChars > 0 && _numChars <= maxVectorDelimiters) {
+        first = findBlocks(first, last, _chars, _numChars);
+    }
+#endif
+    for (; first != last; ++first) {
+        if (contains(*first)) {
+            break;
+        }
+    }
+    return first;
+}
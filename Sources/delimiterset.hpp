@@ -0,0 +1,92 @@
+//
+//  delimiterset.hpp
+//  kssutil
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+
+/*!
+ \file
+ \brief Precomputed set of delimiter characters.
+ */
+
+#ifndef kssutil_delimiterset_hpp
+#define kssutil_delimiterset_hpp
+
+#include <cstddef>
+#include <cstdint>
+
+#include "stringview.hpp"
+
+namespace kss { namespace util { namespace strings {
+
+    /*!
+     \brief Precomputed set of single byte delimiters.
+
+     A DelimiterSet is built once from a string of delimiter characters and may then
+     be used to quickly search for the next delimiter, replacing calls like
+     std::string::find_first_of, which examine the delimiter string for every
+     character searched.
+
+     Membership is stored as a 256 bit bitmap. When the library is compiled with
+     SSE2 (or AVX2) support, and the set has at most maxVectorDelimiters
+     characters, find() examines 16 (or 32) bytes at a time. Otherwise, and for any
+     bytes left over at the end, it checks the bitmap one byte at a time.
+     */
+    class DelimiterSet {
+    public:
+        /*!
+         The largest set for which the vectorized search is used.
+         */
+        static constexpr size_t maxVectorDelimiters = 8;
+
+        /*!
+         Construct the set from the characters in delims. Repeated characters are
+         ignored, and NUL is a valid delimiter.
+         */
+        explicit DelimiterSet(stringview_t delims = stringview_t()) noexcept;
+
+        /*!
+         Returns true if c is one of the delimiters.
+         */
+        bool contains(char c) const noexcept {
+            const auto uc = static_cast<unsigned char>(c);
+            return ((_bits[uc >> 6] >> (uc & 63)) & 1) != 0;
+        }
+
+        /*!
+         Returns the number of distinct delimiters, and true if there are none.
+         */
+        size_t size() const noexcept    { return _numChars; }
+        bool empty() const noexcept     { return (_numChars == 0); }
+
+        /*!
+         Returns a pointer to the first delimiter in [first, last), or last if there
+         is none.
+         */
+        const char* find(const char* first, const char* last) const noexcept;
+
+        /*!
+         Returns the position of the first delimiter in s at or after pos, or
+         stringview_t::npos if there is none.
+         */
+        size_t find(stringview_t s, size_t pos = 0) const noexcept {
+            if (pos >= s.size()) {
+                return stringview_t::npos;
+            }
+            const char* last = s.data() + s.size();
+            const char* p = find(s.data() + pos, last);
+            return (p == last ? stringview_t::npos : size_t(p - s.data()));
+        }
+
+    private:
+        uint64_t    _bits[4];
+        char        _chars[maxVectorDelimiters];
+        size_t      _numChars = 0;
+    };
+
+}}}
+
+#endif
@@ -0,0 +1,528 @@
+//
+//  flatsequentialmap.hpp
+//  kssutil
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+
+/*!
+ \file
+ \brief Insertion ordered hash map stored as a structure of arrays.
+ */
+
+#ifndef kssutil_flatsequentialmap_hpp
+#define kssutil_flatsequentialmap_hpp
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <kss/contract/all.h>
+
+#include "sequentialmap.hpp"
+
+
+namespace kss { namespace util { namespace containers {
+
+    /*!
+     \brief SequentialMap variant using a flat, structure of arrays layout.
+
+     Like a SequentialMap this maintains the order of insertion, but rather than a
+     vector of pairs and a separate node based index, it keeps the keys, the values
+     and the key hashes in separate contiguous arrays (all in insertion order), and
+     uses an open addressing hash table made up of two more arrays: one byte per
+     slot holding a 7 bit fingerprint of the hash (or 0 for an empty slot), and the
+     positions of the items. A lookup scans the fingerprint bytes, which are
+     contiguous, and only compares keys when a fingerprint matches, so most lookups
+     touch one or two cache lines of the table and a single key. Since the keys are
+     stored on their own, scanning all of the keys (see keys()) does not bring the
+     values into the cache, and vice versa.
+
+     The main differences from a SequentialMap are:
+     - Since there are no std::pair objects to refer to, the iterators return a
+       std::pair<const Key&, T&> by value, and operator-> returns a proxy. The
+       iterators are random access.
+     - erase is O(n), as the following items are moved down and renumbered. This
+       class is intended for lookup tables that are built once and rarely erased.
+     - Any insert or erase may invalidate all iterators.
+
+     If Hash and KeyEqual both have an is_transparent member type (e.g.
+     strings::StringHash and std::equal_to<>) then find, count and at will also
+     accept types other than Key.
+     */
+    template <class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+        class Alloc = std::allocator<std::pair<Key, T> > >
+    class FlatSequentialMap {
+        template <class R> struct ArrowProxy;
+        template <class VT> class basic_iterator;
+
+        template <class U>
+        using rebind_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<U>;
+
+        static constexpr bool transparent = (_private::IsTransparent<Hash>::value
+                                             && _private::IsTransparent<KeyEqual>::value);
+
+    public:
+
+        // MARK: The standard type definitions.
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<Key, T>;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+        using allocator_type = Alloc;
+        using reference = std::pair<const Key&, T&>;
+        using const_reference = std::pair<const Key&, const T&>;
+        using iterator = basic_iterator<T>;
+        using const_iterator = basic_iterator<const T>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        using difference_type = std::ptrdiff_t;
+        using size_type = size_t;
+        using key_container_type = std::vector<Key, rebind_alloc<Key>>;
+        using mapped_container_type = std::vector<T, rebind_alloc<T>>;
+
+
+        // MARK: Constructors
+        explicit FlatSequentialMap(const allocator_type& alloc = allocator_type())
+        : _keys(rebind_alloc<Key>(alloc)), _values(rebind_alloc<T>(alloc)), _hashes(rebind_alloc<size_t>(alloc)),
+          _ctrl(rebind_alloc<uint8_t>(alloc)), _slots(rebind_alloc<size_t>(alloc))
+        {}
+
+        template <class InputIterator>
+        FlatSequentialMap(InputIterator first, InputIterator last,
+                          const allocator_type& alloc = allocator_type())
+        : FlatSequentialMap(alloc)
+        {
+            insert(first, last);
+        }
+
+        FlatSequentialMap(const FlatSequentialMap&) = default;
+        FlatSequentialMap(FlatSequentialMap&&) = default;
+        ~FlatSequentialMap() = default;
+
+        FlatSequentialMap& operator=(const FlatSequentialMap&) = default;
+        FlatSequentialMap& operator=(FlatSequentialMap&&) = default;
+
+
+        // MARK: Iterators
+        iterator                begin() noexcept         { return iterator(_keys.data(), _values.data()); }
+        const_iterator          begin() const noexcept   { return const_iterator(_keys.data(), _values.data()); }
+        iterator                end() noexcept           { return begin() + difference_type(size()); }
+        const_iterator          end() const noexcept     { return begin() + difference_type(size()); }
+        reverse_iterator        rbegin() noexcept        { return reverse_iterator(end()); }
+        const_reverse_iterator  rbegin() const noexcept  { return const_reverse_iterator(end()); }
+        reverse_iterator        rend() noexcept          { return reverse_iterator(begin()); }
+        const_reverse_iterator  rend() const noexcept    { return const_reverse_iterator(begin()); }
+        const_iterator          cbegin() const noexcept  { return begin(); }
+        const_iterator          cend() const noexcept    { return end(); }
+        const_reverse_iterator  crbegin() const noexcept { return rbegin(); }
+        const_reverse_iterator  crend() const noexcept   { return rend(); }
+
+
+        // MARK: Capacity
+        bool      empty() const noexcept    { return _keys.empty(); }
+        size_type size() const noexcept     { return _keys.size(); }
+        size_type max_size() const noexcept { return std::min(_keys.max_size(), _values.max_size()); }
+
+        /*!
+         Preallocate enough space for n items, so that they can be added without
+         reallocating the arrays or rehashing.
+         @throws std::length_error if n > max_size()
+         */
+        void reserve(size_type n) {
+            _keys.reserve(n);
+            _values.reserve(n);
+            _hashes.reserve(n);
+            size_t numSlots = 16;
+            while (numSlots * 3 < n * 4) {
+                numSlots *= 2;
+            }
+            if (numSlots > _ctrl.size()) {
+                rehash(numSlots);
+            }
+        }
+
+
+        // MARK: Element access
+        mapped_type& operator[](const key_type& k) {
+            const size_t hash = _hash(k);
+            size_t slot = 0;
+            if (findSlot(k, hash, slot)) {
+                return _values[_slots[slot]];
+            }
+            return _values[append(hash, k, mapped_type())];
+        }
+
+        mapped_type& at(const key_type& k) {
+            return const_cast<mapped_type&>(static_cast<const FlatSequentialMap*>(this)->at(k));
+        }
+
+        const mapped_type& at(const key_type& k) const {
+            size_t idx = 0;
+            if (!findIndex(k, idx)) {
+                throw std::out_of_range("the given key is not found in the map");
+            }
+            return _values[idx];
+        }
+
+        template <class K, bool B = transparent, class = typename std::enable_if<B>::type>
+        mapped_type& at(const K& k) {
+            return const_cast<mapped_type&>(static_cast<const FlatSequentialMap*>(this)->at(k));
+        }
+
+        template <class K, bool B = transparent, class = typename std::enable_if<B>::type>
+        const mapped_type& at(const K& k) const {
+            size_t idx = 0;
+            if (!findIndex(k, idx)) {
+                throw std::out_of_range("the given key is not found in the map");
+            }
+            return _values[idx];
+        }
+
+        /*!
+         Direct read-only access to the arrays of keys and values, in insertion order.
+         */
+        const key_container_type& keys() const noexcept         { return _keys; }
+        const mapped_container_type& values() const noexcept    { return _values; }
+
+        hasher          hash_function() const   { return _hash; }
+        key_equal       key_eq() const          { return _equal; }
+        allocator_type  get_allocator() const   { return allocator_type(_keys.get_allocator()); }
+
+
+        // MARK: Modifiers
+        std::pair<iterator, bool> insert(const value_type& val) {
+            const size_t hash = _hash(val.first);
+            size_t slot = 0;
+            if (findSlot(val.first, hash, slot)) {
+                return std::make_pair(begin() + difference_type(_slots[slot]), false);
+            }
+            const size_t idx = append(hash, val.first, val.second);
+            return std::make_pair(begin() + difference_type(idx), true);
+        }
+
+        iterator insert(const_iterator, const value_type& val) {
+            return insert(val).first;
+        }
+
+        template <class InputIterator>
+        void insert(InputIterator first, InputIterator last) {
+            reserveForRange(first, last, typename std::iterator_traits<InputIterator>::iterator_category());
+            for (InputIterator it = first; it != last; ++it) {
+                insert(*it);
+            }
+
+            kss::contract::postconditions({
+                KSS_EXPR(_keys.size() == _values.size()),
+                KSS_EXPR(_keys.size() == _hashes.size())
+            });
+        }
+
+        // Note that invalid_argument is thrown if first and last are not in
+        // the map or are not in the correct order.
+        iterator erase(const_iterator position) {
+            return erase(position, std::next(position));
+        }
+
+        size_type erase(const key_type& k) {
+            size_t idx = 0;
+            if (!findIndex(k, idx)) {
+                return 0;
+            }
+            erase(cbegin() + difference_type(idx));
+            return 1;
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            const Key* data = _keys.data();
+            if (first._key < data || last._key < first._key || last._key > data + size()) {
+                throw std::invalid_argument("iterator(s) are not valid for this FlatSequentialMap");
+            }
+            const size_t i = size_t(first._key - data);
+            const size_t j = size_t(last._key - data);
+            if (i == j) {
+                return begin() + difference_type(i);
+            }
+
+            for (size_t idx = i; idx < j; ++idx) {
+                eraseSlot(idx);
+            }
+            _keys.erase(_keys.begin() + difference_type(i), _keys.begin() + difference_type(j));
+            _values.erase(_values.begin() + difference_type(i), _values.begin() + difference_type(j));
+            _hashes.erase(_hashes.begin() + difference_type(i), _hashes.begin() + difference_type(j));
+            const size_t n = j - i;
+            for (size_t s = 0, numSlots = _ctrl.size(); s < numSlots; ++s) {
+                if (_ctrl[s] != 0 && _slots[s] >= j) {
+                    _slots[s] -= n;
+                }
+            }
+
+            kss::contract::postconditions({
+                KSS_EXPR(_keys.size() == _values.size()),
+                KSS_EXPR(_keys.size() == _hashes.size())
+            });
+            return begin() + difference_type(i);
+        }
+
+        void swap(FlatSequentialMap& x) {
+            _keys.swap(x._keys);
+            _values.swap(x._values);
+            _hashes.swap(x._hashes);
+            _ctrl.swap(x._ctrl);
+            _slots.swap(x._slots);
+            std::swap(_hash, x._hash);
+            std::swap(_equal, x._equal);
+        }
+
+        void clear() noexcept {
+            _keys.clear();
+            _values.clear();
+            _hashes.clear();
+            std::fill(_ctrl.begin(), _ctrl.end(), 0);
+        }
+
+
+        // MARK: Operations
+        iterator find(const key_type& k) {
+            size_t idx = 0;
+            return (findIndex(k, idx) ? begin() + difference_type(idx) : end());
+        }
+
+        const_iterator find(const key_type& k) const {
+            size_t idx = 0;
+            return (findIndex(k, idx) ? begin() + difference_type(idx) : end());
+        }
+
+        size_type count(const key_type& k) const {
+            size_t idx = 0;
+            return (findIndex(k, idx) ? 1 : 0);
+        }
+
+        // Transparent versions of the above.
+        template <class K, bool B = transparent, class = typename std::enable_if<B>::type>
+        iterator find(const K& k) {
+            size_t idx = 0;
+            return (findIndex(k, idx) ? begin() + difference_type(idx) : end());
+        }
+
+        template <class K, bool B = transparent, class = typename std::enable_if<B>::type>
+        const_iterator find(const K& k) const {
+            size_t idx = 0;
+            return (findIndex(k, idx) ? begin() + difference_type(idx) : end());
+        }
+
+        template <class K, bool B = transparent, class = typename std::enable_if<B>::type>
+        size_type count(const K& k) const {
+            size_t idx = 0;
+            return (findIndex(k, idx) ? 1 : 0);
+        }
+
+    private:
+        // Holds the pair returned by an iterator so that operator-> has something to
+        // point to.
+        template <class R>
+        struct ArrowProxy {
+            R ref;
+            const R* operator->() const noexcept { return &ref; }
+        };
+
+        // Random access iterator over the parallel key and value arrays.
+        template <class VT>
+        class basic_iterator {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::pair<Key, T>;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::pair<const Key&, VT&>;
+            using pointer = ArrowProxy<reference>;
+
+            basic_iterator() = default;
+
+            template <class OVT, class = typename std::enable_if<std::is_convertible<OVT*, VT*>::value>::type>
+            basic_iterator(const basic_iterator<OVT>& it) noexcept : _key(it._key), _value(it._value) {}
+
+            reference operator*() const noexcept        { return reference(*_key, *_value); }
+            pointer operator->() const noexcept         { return pointer { **this }; }
+            reference operator[](difference_type n) const noexcept { return reference(_key[n], _value[n]); }
+
+            // Direct access to the key and value without constructing a pair.
+            const Key& key() const noexcept             { return *_key; }
+            VT& value() const noexcept                  { return *_value; }
+
+            basic_iterator& operator++() noexcept       { ++_key; ++_value; return *this; }
+            basic_iterator& operator--() noexcept       { --_key; --_value; return *this; }
+            basic_iterator operator++(int) noexcept     { basic_iterator tmp(*this); ++*this; return tmp; }
+            basic_iterator operator--(int) noexcept     { basic_iterator tmp(*this); --*this; return tmp; }
+            basic_iterator& operator+=(difference_type n) noexcept { _key += n; _value += n; return *this; }
+            basic_iterator& operator-=(difference_type n) noexcept { _key -= n; _value -= n; return *this; }
+
+            // The operators are friends so that an iterator and a const_iterator may
+            // be mixed.
+            friend basic_iterator operator+(basic_iterator it, difference_type n) noexcept { return it += n; }
+            friend basic_iterator operator+(difference_type n, basic_iterator it) noexcept { return it += n; }
+            friend basic_iterator operator-(basic_iterator it, difference_type n) noexcept { return it -= n; }
+            friend difference_type operator-(const basic_iterator& a, const basic_iterator& b) noexcept {
+                return a._key - b._key;
+            }
+            friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept { return a._key == b._key; }
+            friend bool operator!=(const basic_iterator& a, const basic_iterator& b) noexcept { return a._key != b._key; }
+            friend bool operator<(const basic_iterator& a, const basic_iterator& b) noexcept  { return a._key < b._key; }
+            friend bool operator<=(const basic_iterator& a, const basic_iterator& b) noexcept { return a._key <= b._key; }
+            friend bool operator>(const basic_iterator& a, const basic_iterator& b) noexcept  { return a._key > b._key; }
+            friend bool operator>=(const basic_iterator& a, const basic_iterator& b) noexcept { return a._key >= b._key; }
+
+        private:
+            friend class FlatSequentialMap;
+            template <class OVT> friend class basic_iterator;
+
+            basic_iterator(const Key* key, VT* value) noexcept : _key(key), _value(value) {}
+
+            const Key*  _key = nullptr;
+            VT*         _value = nullptr;
+        };
+
+        key_container_type                  _keys;
+        mapped_container_type               _values;
+        std::vector<size_t, rebind_alloc<size_t>>   _hashes;    // hash of each key
+        std::vector<uint8_t, rebind_alloc<uint8_t>> _ctrl;      // fingerprint of each slot, 0 if empty
+        std::vector<size_t, rebind_alloc<size_t>>   _slots;     // position of the item in each slot
+        Hash                                _hash;
+        KeyEqual                            _equal;
+
+        // Scramble the hash so that poor hash functions still spread out over the
+        // table. The low bits choose the home slot and the high bits the fingerprint.
+        static uint64_t mix(size_t hash) noexcept {
+            uint64_t h = uint64_t(hash) * UINT64_C(0x9E3779B97F4A7C15);
+            return h ^ (h >> 32);
+        }
+        static uint8_t fingerprintOf(uint64_t m) noexcept   { return uint8_t(0x80 | (m >> 57)); }
+        size_t homeOf(uint64_t m) const noexcept            { return size_t(m) & (_ctrl.size() - 1); }
+
+        // Returns true and sets slot if k is found, otherwise sets slot to the empty
+        // slot where it would be placed.
+        template <class K>
+        bool findSlot(const K& k, size_t hash, size_t& slot) const {
+            if (_ctrl.empty()) {
+                return false;
+            }
+            const uint64_t m = mix(hash);
+            const uint8_t fp = fingerprintOf(m);
+            const size_t mask = _ctrl.size() - 1;
+            for (slot = homeOf(m); _ctrl[slot] != 0; slot = (slot + 1) & mask) {
+                if (_ctrl[slot] == fp && _equal(_keys[_slots[slot]], k)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        template <class K>
+        bool findIndex(const K& k, size_t& idx) const {
+            size_t slot = 0;
+            if (!findSlot(k, _hash(k), slot)) {
+                return false;
+            }
+            idx = _slots[slot];
+            return true;
+        }
+
+        // Add an item that is known not to be in the map, returning its position.
+        template <class V>
+        size_t append(size_t hash, const key_type& k, V&& v) {
+            const size_t idx = _keys.size();
+            if ((idx + 1) * 4 > _ctrl.size() * 3) {
+                rehash(std::max(size_t(16), _ctrl.size() * 2));
+            }
+
+            _hashes.push_back(hash);
+            try {
+                _keys.push_back(k);
+                try {
+                    _values.push_back(std::forward<V>(v));
+                }
+                catch (...) {
+                    _keys.pop_back();
+                    throw;
+                }
+            }
+            catch (...) {
+                _hashes.pop_back();
+                throw;
+            }
+            place(hash, idx);
+            return idx;
+        }
+
+        void place(size_t hash, size_t idx) noexcept {
+            const uint64_t m = mix(hash);
+            const size_t mask = _ctrl.size() - 1;
+            size_t slot = homeOf(m);
+            while (_ctrl[slot] != 0) {
+                slot = (slot + 1) & mask;
+            }
+            _ctrl[slot] = fingerprintOf(m);
+            _slots[slot] = idx;
+        }
+
+        // Remove the slot referring to position idx using backward shift deletion.
+        void eraseSlot(size_t idx) noexcept {
+            const size_t mask = _ctrl.size() - 1;
+            size_t hole = homeOf(mix(_hashes[idx]));
+            while (_slots[hole] != idx || _ctrl[hole] == 0) {
+                hole = (hole + 1) & mask;
+            }
+            for (size_t next = (hole + 1) & mask; _ctrl[next] != 0; next = (next + 1) & mask) {
+                const size_t home = homeOf(mix(_hashes[_slots[next]]));
+                if (((next - home) & mask) >= ((next - hole) & mask)) {
+                    _ctrl[hole] = _ctrl[next];
+                    _slots[hole] = _slots[next];
+                    hole = next;
+                }
+            }
+            _ctrl[hole] = 0;
+        }
+
+        // The stored hashes are used so that the hash function is not called again.
+        void rehash(size_t numSlots) {
+            std::vector<uint8_t, rebind_alloc<uint8_t>> ctrl(numSlots, 0, _ctrl.get_allocator());
+            std::vector<size_t, rebind_alloc<size_t>> slots(numSlots, 0, _slots.get_allocator());
+            _ctrl.swap(ctrl);
+            _slots.swap(slots);
+            for (size_t idx = 0, n = _keys.size(); idx < n; ++idx) {
+                place(_hashes[idx], idx);
+            }
+        }
+
+        // Preallocate for a range if we can determine its size without consuming it.
+        template <class InputIterator>
+        void reserveForRange(InputIterator, InputIterator, std::input_iterator_tag) {}
+
+        template <class ForwardIterator>
+        void reserveForRange(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+            reserve(size() + size_t(std::distance(first, last)));
+        }
+    };
+
+    template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+    constexpr bool FlatSequentialMap<Key, T, Hash, KeyEqual, Alloc>::transparent;
+
+
+    template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+    inline void swap(FlatSequentialMap<Key, T, Hash, KeyEqual, Alloc>& x,
+                     FlatSequentialMap<Key, T, Hash, KeyEqual, Alloc>& y)
+    {
+        x.swap(y);
+    }
+
+}}}
+
+#endif
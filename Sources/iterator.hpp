@@ -399,6 +399,288 @@ namespace kss { namespace util { namespace iterators {
     }
 
 
+    /*!
+     \brief Random access iterator over the elements of a ring buffer.
+
+     The CircularIterator class provides a random access iterator for containers that
+     store their elements in a single array that is referenced in a circular manner
+     (e.g. CircularArray). Instead of translating a logical index into a physical one
+     on every access, as RandomAccessIterator would, it walks a raw pointer through the
+     array and only checks for wrap-around when it reaches the end of the storage. In
+     addition it tracks the logical position, which is used for the comparison and
+     difference operators.
+
+     The container must provide the value_type, difference_type, size_type, pointer
+     and reference types. Typically the containers begin() and end() methods would be
+     defined as follows, where first is the physical slot of the first element, and
+     last is the physical slot just past the last element:
+
+     @code
+     using iterator = kss::util::iterators::CircularIterator<Container>;
+     using const_iterator = kss::util::iterators::ConstCircularIterator<Container>;
+     iterator begin() noexcept { return iterator(array, capacity, first, 0); }
+     iterator end() noexcept { return iterator(array, capacity, last, size); }
+     @endcode
+     */
+    template <typename Container>
+    class CircularIterator
+    : public kss::util::AddRelOps<CircularIterator<Container>>,
+      public std::iterator<
+        std::random_access_iterator_tag,
+        typename Container::value_type,
+        typename Container::difference_type,
+        typename Container::pointer,
+        typename Container::reference >
+    {
+    public:
+        using size_type = typename Container::size_type;
+        using difference_type = typename Container::difference_type;
+        using pointer = typename Container::pointer;
+        using reference = typename Container::reference;
+
+        CircularIterator() = default;
+
+        CircularIterator(pointer base, size_type capacity, size_type slot, size_type pos) noexcept
+        : _ptr(base+slot), _base(base), _end(base+capacity), _pos(pos)
+        {}
+
+        CircularIterator(const CircularIterator&) = default;
+        ~CircularIterator() noexcept = default;
+        CircularIterator& operator=(const CircularIterator&) noexcept = default;
+
+        // Two iterators are considered equal if they are both pointing to the same logical
+        // position of the same storage. The inequality comparisons only check the positions.
+        // Note that the "missing" comparison operators are added via the AddRelOps declaration.
+        bool operator==(const CircularIterator& rhs) const noexcept {
+            return (_base == rhs._base && _pos == rhs._pos);
+        }
+        bool operator<(const CircularIterator& rhs) const noexcept {
+            return (_pos < rhs._pos);
+        }
+
+        // Dereference the iterators. As with the other random access iterators, we do
+        // not check if the iterator is valid.
+        reference operator*() const noexcept            { return *_ptr; }
+        pointer operator->() const noexcept             { return _ptr; }
+        reference operator[](difference_type i) const noexcept { return *(*this + i); }
+
+        // Pointer arithmetic. The wrap-around check is only made when we reach the end
+        // (or the start) of the underlying storage. For efficiency reasons we do not check
+        // if the resulting position is valid.
+        CircularIterator& operator++() noexcept {
+            ++_pos;
+            if (++_ptr == _end) {
+                _ptr = _base;
+            }
+            return *this;
+        }
+        CircularIterator operator++(int) noexcept {
+            CircularIterator tmp(*this);
+            operator++();
+            return tmp;
+        }
+        CircularIterator& operator+=(difference_type n) noexcept {
+            _pos += size_type(n);
+            difference_type offset = (_ptr - _base) + n;
+            const difference_type capacity = _end - _base;
+            if (offset >= capacity) {
+                offset -= capacity;
+            }
+            else if (offset < 0) {
+                offset += capacity;
+            }
+            _ptr = _base + offset;
+            return *this;
+        }
+        CircularIterator operator+(difference_type n) const noexcept {
+            CircularIterator tmp(*this);
+            tmp += n;
+            return tmp;
+        }
+
+        CircularIterator& operator--() noexcept {
+            --_pos;
+            if (_ptr == _base) {
+                _ptr = _end;
+            }
+            --_ptr;
+            return *this;
+        }
+        CircularIterator operator--(int) noexcept {
+            CircularIterator tmp(*this);
+            operator--();
+            return tmp;
+        }
+        CircularIterator& operator-=(difference_type n) noexcept {
+            return operator+=(-n);
+        }
+        CircularIterator operator-(difference_type n) const noexcept {
+            CircularIterator tmp(*this);
+            tmp -= n;
+            return tmp;
+        }
+        difference_type operator-(const CircularIterator& rhs) const noexcept {
+            return difference_type(_pos >= rhs._pos ? _pos - rhs._pos : -(rhs._pos - _pos));
+        }
+
+        /*!
+         Swap with another iterator.
+         */
+        void swap(CircularIterator& b) noexcept {
+            if (this != &b) {
+                std::swap(_ptr, b._ptr);
+                std::swap(_base, b._base);
+                std::swap(_end, b._end);
+                std::swap(_pos, b._pos);
+            }
+        }
+
+    private:
+        template <typename C> friend class ConstCircularIterator;
+
+        pointer     _ptr = nullptr;
+        pointer     _base = nullptr;
+        pointer     _end = nullptr;
+        size_type   _pos = 0;
+    };
+
+    template <typename Container>
+    inline CircularIterator<Container> operator+(typename Container::difference_type n,
+                                                 const CircularIterator<Container>& c) noexcept
+    {
+        return (c + n);
+    }
+
+
+    /*!
+     \brief Const version of CircularIterator.
+
+     The comments for CircularIterator follow for this one as well. In addition a
+     ConstCircularIterator may be constructed from a CircularIterator.
+     */
+    template <typename Container>
+    class ConstCircularIterator
+    : public kss::util::AddRelOps<ConstCircularIterator<Container>>,
+      public std::iterator<
+        std::random_access_iterator_tag,
+        typename Container::value_type,
+        typename Container::difference_type,
+        typename Container::const_pointer,
+        typename Container::const_reference >
+    {
+    public:
+        using size_type = typename Container::size_type;
+        using difference_type = typename Container::difference_type;
+        using pointer = typename Container::const_pointer;
+        using reference = typename Container::const_reference;
+
+        ConstCircularIterator() = default;
+
+        ConstCircularIterator(pointer base, size_type capacity, size_type slot, size_type pos) noexcept
+        : _ptr(base+slot), _base(base), _end(base+capacity), _pos(pos)
+        {}
+
+        ConstCircularIterator(const CircularIterator<Container>& it) noexcept
+        : _ptr(it._ptr), _base(it._base), _end(it._end), _pos(it._pos)
+        {}
+
+        ConstCircularIterator(const ConstCircularIterator&) = default;
+        ~ConstCircularIterator() noexcept = default;
+        ConstCircularIterator& operator=(const ConstCircularIterator&) noexcept = default;
+
+        bool operator==(const ConstCircularIterator& rhs) const noexcept {
+            return (_base == rhs._base && _pos == rhs._pos);
+        }
+        bool operator<(const ConstCircularIterator& rhs) const noexcept {
+            return (_pos < rhs._pos);
+        }
+
+        reference operator*() const noexcept            { return *_ptr; }
+        pointer operator->() const noexcept             { return _ptr; }
+        reference operator[](difference_type i) const noexcept { return *(*this + i); }
+
+        ConstCircularIterator& operator++() noexcept {
+            ++_pos;
+            if (++_ptr == _end) {
+                _ptr = _base;
+            }
+            return *this;
+        }
+        ConstCircularIterator operator++(int) noexcept {
+            ConstCircularIterator tmp(*this);
+            operator++();
+            return tmp;
+        }
+        ConstCircularIterator& operator+=(difference_type n) noexcept {
+            _pos += size_type(n);
+            difference_type offset = (_ptr - _base) + n;
+            const difference_type capacity = _end - _base;
+            if (offset >= capacity) {
+                offset -= capacity;
+            }
+            else if (offset < 0) {
+                offset += capacity;
+            }
+            _ptr = _base + offset;
+            return *this;
+        }
+        ConstCircularIterator operator+(difference_type n) const noexcept {
+            ConstCircularIterator tmp(*this);
+            tmp += n;
+            return tmp;
+        }
+
+        ConstCircularIterator& operator--() noexcept {
+            --_pos;
+            if (_ptr == _base) {
+                _ptr = _end;
+            }
+            --_ptr;
+            return *this;
+        }
+        ConstCircularIterator operator--(int) noexcept {
+            ConstCircularIterator tmp(*this);
+            operator--();
+            return tmp;
+        }
+        ConstCircularIterator& operator-=(difference_type n) noexcept {
+            return operator+=(-n);
+        }
+        ConstCircularIterator operator-(difference_type n) const noexcept {
+            ConstCircularIterator tmp(*this);
+            tmp -= n;
+            return tmp;
+        }
+        difference_type operator-(const ConstCircularIterator& rhs) const noexcept {
+            return difference_type(_pos >= rhs._pos ? _pos - rhs._pos : -(rhs._pos - _pos));
+        }
+
+        /*!
+         Swap with another iterator.
+         */
+        void swap(ConstCircularIterator& b) noexcept {
+            if (this != &b) {
+                std::swap(_ptr, b._ptr);
+                std::swap(_base, b._base);
+                std::swap(_end, b._end);
+                std::swap(_pos, b._pos);
+            }
+        }
+
+    private:
+        pointer     _ptr = nullptr;
+        pointer     _base = nullptr;
+        pointer     _end = nullptr;
+        size_type   _pos = 0;
+    };
+
+    template <typename Container>
+    inline ConstCircularIterator<Container> operator+(typename Container::difference_type n,
+                                                      const ConstCircularIterator<Container>& c) noexcept
+    {
+        return (c + n);
+    }
+
     /*!
      \brief Base implementation of a random access iterator that generate elements as needed.
      
@@ -547,6 +829,20 @@ namespace std {
         a.swap(b);
     }
 
+    template <typename Container>
+    inline void swap(kss::util::iterators::CircularIterator<Container>& a,
+                     kss::util::iterators::CircularIterator<Container>& b)
+    {
+        a.swap(b);
+    }
+
+    template <typename Container>
+    inline void swap(kss::util::iterators::ConstCircularIterator<Container>& a,
+                     kss::util::iterators::ConstCircularIterator<Container>& b)
+    {
+        a.swap(b);
+    }
+
     template <typename Container>
     inline void swap(kss::util::iterators::CopyRandomAccessIterator<Container>& a,
                      kss::util::iterators::CopyRandomAccessIterator<Container>& b)
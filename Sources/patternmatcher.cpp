@@ -0,0 +1,214 @@
+//
+//  patternmatcher.cpp
+//  kssutil
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+#include <kss/contract/all.h>
+
+#include "patternmatcher.hpp"
+
+using namespace std;
+using namespace kss::util::strings;
+
+namespace contract = kss::contract;
+
+constexpr uint32_t PatternMatcher::none;
+constexpr uint32_t PatternMatcher::reportFlag;
+constexpr uint32_t PatternMatcher::rowMask;
+
+
+PatternMatcher::PatternMatcher(const vector<string>& patterns) {
+    build(patterns.begin(), patterns.end());
+}
+
+PatternMatcher::PatternMatcher(initializer_list<stringview_t> patterns) {
+    build(patterns.begin(), patterns.end());
+}
+
+
+// Build the trie of the patterns, then fill in the missing transitions breadth
+// first. A missing transition from a state is the same as the transition from its
+// failure state, the state for the longest proper suffix of its string that is also
+// in the trie, which being shorter has already been completed.
+template <class InputIterator>
+void PatternMatcher::build(InputIterator first, InputIterator last) {
+    const vector<stringview_t> patterns(first, last);
+    contract::parameters({
+        KSS_EXPR(none_of(patterns.begin(), patterns.end(), [](stringview_t p) { return p.empty(); }))
+    });
+
+    // Class 0 is shared by all the characters not in any pattern.
+    bool used[256] = { false };
+    for (const auto& p : patterns) {
+        for (char ch : p) {
+            used[static_cast<unsigned char>(ch)] = true;
+        }
+    }
+    for (size_t i = 0; i < 256; ++i) {
+        _classOf[i] = (used[i] ? static_cast<uint16_t>(_numClasses++) : 0);
+    }
+    const size_t k = _numClasses;
+
+    // The trie.
+    vector<vector<uint32_t>> own(1);
+    _next.assign(k, none);
+    _lengths.reserve(patterns.size());
+    for (size_t i = 0; i < patterns.size(); ++i) {
+        uint32_t state = 0;
+        for (char ch : patterns[i]) {
+            const size_t idx = state * k + _classOf[static_cast<unsigned char>(ch)];
+            if (_next[idx] == none) {
+                _next[idx] = static_cast<uint32_t>(own.size());
+                _next.resize(_next.size() + k, none);
+                own.emplace_back();
+            }
+            state = _next[idx];
+        }
+        own[state].push_back(static_cast<uint32_t>(i));
+        _lengths.push_back(patterns[i].size());
+    }
+
+    // The failure and dictionary links, and the remaining transitions.
+    const size_t numStates = own.size();
+    vector<uint32_t> fail(numStates, 0);
+    _dictLink.assign(numStates, none);
+    vector<uint32_t> pending;
+    pending.reserve(numStates);
+    for (size_t c = 0; c < k; ++c) {
+        if (_next[c] == none) {
+            _next[c] = 0;
+        }
+        else {
+            pending.push_back(_next[c]);
+        }
+    }
+    for (size_t i = 0; i < pending.size(); ++i) {
+        const uint32_t state = pending[i];
+        const size_t row = state * k;
+        const size_t failRow = fail[state] * k;
+        for (size_t c = 0; c < k; ++c) {
+            const uint32_t target = _next[row + c];
+            if (target == none) {
+                _next[row + c] = _next[failRow + c];
+            }
+            else {
+                const uint32_t f = _next[failRow + c];
+                fail[target] = f;
+                _dictLink[target] = (own[f].empty() ? _dictLink[f] : f);
+                pending.push_back(target);
+            }
+        }
+    }
+
+    _outputBegin.reserve(numStates + 1);
+    for (size_t s = 0; s < numStates; ++s) {
+        _outputBegin.push_back(static_cast<uint32_t>(_outputs.size()));
+        _outputs.insert(_outputs.end(), own[s].begin(), own[s].end());
+    }
+    _outputBegin.push_back(static_cast<uint32_t>(_outputs.size()));
+
+    // Replace each target state by the offset of its row, flagged if the state has
+    // outputs, so that the search needs neither a multiplication nor another lookup.
+    if (_next.size() > rowMask) {
+        throw length_error("Too many patterns for a PatternMatcher");
+    }
+    for (auto& target : _next) {
+        const bool reports = (!own[target].empty() || _dictLink[target] != none);
+        target = static_cast<uint32_t>(target * k) | (reports ? reportFlag : 0);
+    }
+}
+
+
+size_t PatternMatcher::count(stringview_t s, bool allowOverlaps) const {
+    Stream stream(*this, allowOverlaps);
+    stream.scan(s);
+    return accumulate(stream.counts().begin(), stream.counts().end(), size_t(0));
+}
+
+vector<size_t> PatternMatcher::countEach(stringview_t s, bool allowOverlaps) const {
+    Stream stream(*this, allowOverlaps);
+    stream.scan(s);
+    return stream.counts();
+}
+
+void PatternMatcher::find(stringview_t s, bool allowOverlaps, const callback_t& fn) const {
+    Stream stream(*this, allowOverlaps);
+    stream.scan(s, fn);
+}
+
+
+// MARK: PatternMatcher::Stream
+
+PatternMatcher::Stream::Stream(const PatternMatcher& matcher, bool allowOverlaps)
+: _matcher(matcher), _allowOverlaps(allowOverlaps), _counts(matcher.size(), 0)
+{
+    if (!allowOverlaps) {
+        _nextAllowed.resize(matcher.size(), 0);
+    }
+}
+
+void PatternMatcher::Stream::scan(stringview_t s) {
+    scanImpl(s, [](size_t, size_t) {});
+}
+
+void PatternMatcher::Stream::scan(stringview_t s, const callback_t& fn) {
+    if (fn) {
+        scanImpl(s, fn);
+    }
+    else {
+        scan(s);
+    }
+}
+
+void PatternMatcher::Stream::reset() noexcept {
+    _state = 0;
+    _position = 0;
+    fill(_counts.begin(), _counts.end(), 0);
+    fill(_nextAllowed.begin(), _nextAllowed.end(), 0);
+}
+
+template <class Fn>
+void PatternMatcher::Stream::scanImpl(stringview_t s, Fn fn) {
+    const uint32_t* next = _matcher._next.data();
+    const uint16_t* classOf = _matcher._classOf;
+    const auto* p = reinterpret_cast<const unsigned char*>(s.data());
+
+    uint32_t entry = _state;
+    for (size_t i = 0, n = s.size(); i < n; ++i) {
+        entry = next[(entry & rowMask) + classOf[p[i]]];
+        if (entry & reportFlag) {
+            report(entry, _position + i + 1, fn);
+        }
+    }
+    _state = entry;
+    _position += s.size();
+}
+
+// Report the patterns ending at the state of the given entry, whose last character
+// is at end-1.
+template <class Fn>
+void PatternMatcher::Stream::report(uint32_t entry, size_t end, Fn& fn) {
+    const uint32_t state = (entry & rowMask) / _matcher._numClasses;
+    for (uint32_t st = state; st != none; st = _matcher._dictLink[st]) {
+        for (uint32_t i = _matcher._outputBegin[st], last = _matcher._outputBegin[st+1]; i < last; ++i) {
+            const uint32_t pattern = _matcher._outputs[i];
+            const size_t start = end - _matcher._lengths[pattern];
+            if (!_allowOverlaps) {
+                if (start < _nextAllowed[pattern]) {
+                    continue;
+                }
+                _nextAllowed[pattern] = end;
+            }
+            ++_counts[pattern];
+            fn(pattern, start);
+        }
+    }
+}
@@ -0,0 +1,155 @@
+//
+//  patternmatcher.hpp
+//  kssutil
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+
+/*!
+ \file
+ \brief Search for many substrings at once.
+ */
+
+#ifndef kssutil_patternmatcher_hpp
+#define kssutil_patternmatcher_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include "stringview.hpp"
+
+namespace kss { namespace util { namespace strings {
+
+    /*!
+     \brief Precomputed set of substrings to search for.
+
+     A PatternMatcher is built once from a list of patterns and may then be used to
+     count or locate all of them in a single pass over the text, replacing a call to
+     countOccurrencesOf for each pattern. The time taken is proportional to the
+     length of the text plus the number of matches, regardless of the number of
+     patterns.
+
+     This is an Aho-Corasick automaton with every transition precomputed. To keep
+     the table small the characters are first mapped to classes, one for each
+     distinct character used in the patterns and one for all of the others, and the
+     table has a row of that many entries for each distinct prefix of the patterns.
+
+     As with countOccurrencesOf, each pattern is counted independently of the others.
+     If overlaps are not allowed, an occurrence of a pattern is only counted if it
+     starts after the end of the previous counted occurrence of that same pattern.
+
+     Text may be searched all at once, or in pieces using a Stream, in which case
+     occurrences spanning the pieces are still found.
+     */
+    class PatternMatcher {
+    public:
+        /*!
+         The function called for each occurrence found. The arguments are the index
+         of the pattern, in the list given to the constructor, and the position of
+         the start of the occurrence in the text.
+         */
+        using callback_t = std::function<void(size_t pattern, size_t position)>;
+
+        /*!
+         Construct the matcher from a list of patterns. The patterns are copied, so
+         they need not outlive the matcher. Repeated patterns are each reported.
+         @throws std::invalid_argument if any of the patterns are empty
+         @throws std::length_error if the automaton would have 2^31 or more entries
+         @throws std::bad_alloc if the automaton could not be allocated
+         */
+        explicit PatternMatcher(const std::vector<std::string>& patterns);
+        PatternMatcher(std::initializer_list<stringview_t> patterns);
+
+        /*!
+         Returns the number of patterns.
+         */
+        size_t size() const noexcept { return _lengths.size(); }
+
+        /*!
+         Count the occurrences of the patterns in s.
+         @return the total number of occurrences, or in the case of countEach, a
+            vector giving the number of occurrences of each pattern
+         */
+        size_t count(stringview_t s, bool allowOverlaps = false) const;
+        std::vector<size_t> countEach(stringview_t s, bool allowOverlaps = false) const;
+
+        /*!
+         Call fn for each occurrence of the patterns in s, in the order of the end of
+         the occurrence. Occurrences ending at the same position are reported longest
+         first.
+         */
+        void find(stringview_t s, bool allowOverlaps, const callback_t& fn) const;
+
+        /*!
+         \brief Search of text that arrives in pieces.
+
+         A Stream holds the state of a search between calls to scan(), so that
+         occurrences that span the pieces are found. Positions are relative to the
+         start of the first piece. The matcher must outlive the stream.
+         */
+        class Stream {
+        public:
+            explicit Stream(const PatternMatcher& matcher, bool allowOverlaps = false);
+
+            /*!
+             Search the next piece of the text, adding the occurrences found to
+             counts(). If fn is given it is also called for each occurrence.
+             */
+            void scan(stringview_t s);
+            void scan(stringview_t s, const callback_t& fn);
+
+            /*!
+             Returns the number of occurrences of each pattern found so far.
+             */
+            const std::vector<size_t>& counts() const noexcept { return _counts; }
+
+            /*!
+             Returns the total number of characters scanned.
+             */
+            size_t position() const noexcept { return _position; }
+
+            /*!
+             Start again, as if nothing had been scanned.
+             */
+            void reset() noexcept;
+
+        private:
+            const PatternMatcher&   _matcher;
+            bool                    _allowOverlaps;
+            uint32_t                _state = 0;         // entry in _matcher._next
+            size_t                  _position = 0;
+            std::vector<size_t>     _counts;
+            std::vector<size_t>     _nextAllowed;   // earliest start of the next counted occurrence
+
+            template <class Fn>
+            void scanImpl(stringview_t s, Fn fn);
+            template <class Fn>
+            void report(uint32_t entry, size_t end, Fn& fn);
+        };
+
+    private:
+        static constexpr uint32_t none = static_cast<uint32_t>(-1);
+        static constexpr uint32_t reportFlag = 0x80000000;
+        static constexpr uint32_t rowMask = 0x7fffffff;
+
+        uint16_t                _classOf[256];
+        uint32_t                _numClasses = 1;
+        std::vector<uint32_t>   _next;          // _next[state * _numClasses + class], see build()
+        std::vector<uint32_t>   _outputBegin;   // patterns ending at state s are
+        std::vector<uint32_t>   _outputs;       //   _outputs[_outputBegin[s], _outputBegin[s+1])
+        std::vector<uint32_t>   _dictLink;      // next state on the failure chain with outputs
+        std::vector<size_t>     _lengths;
+
+        template <class InputIterator>
+        void build(InputIterator first, InputIterator last);
+    };
+
+}}}
+
+#endif
@@ -0,0 +1,143 @@
+//
+//  prefixmatcher.cpp
+//  kssutil
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <utility>
+
+#include "prefixmatcher.hpp"
+
+using namespace std;
+using namespace kss::util::strings;
+
+
+constexpr size_t PrefixMatcher::npos;
+
+namespace {
+
+    // Uncompressed trie used while the prefixes are added.
+    struct BuildNode {
+        map<unsigned char, unique_ptr<BuildNode>>   children;
+        size_t                                      prefix = PrefixMatcher::npos;
+    };
+
+    // Below this many children a linear search is faster than a binary one.
+    constexpr uint32_t maxLinearSearch = 8;
+}
+
+
+PrefixMatcher::PrefixMatcher(const vector<string>& prefixes) {
+    build(prefixes.begin(), prefixes.end());
+}
+
+PrefixMatcher::PrefixMatcher(initializer_list<stringview_t> prefixes) {
+    build(prefixes.begin(), prefixes.end());
+}
+
+
+// Build the trie one character per node, then copy it breadth first into _nodes,
+// merging each chain of nodes that have a single child and end no prefix into the
+// run of the node at its head. Breadth first order keeps the children of each node
+// together.
+template <class InputIterator>
+void PrefixMatcher::build(InputIterator first, InputIterator last) {
+    BuildNode root;
+    for (; first != last; ++first) {
+        const stringview_t prefix(*first);
+        BuildNode* node = &root;
+        for (size_t i = 0; i < prefix.size(); ++i) {
+            auto& child = node->children[static_cast<unsigned char>(prefix[i])];
+            if (!child) {
+                child.reset(new BuildNode());
+            }
+            node = child.get();
+        }
+        if (node->prefix == npos) {
+            node->prefix = _numPrefixes;
+        }
+        ++_numPrefixes;
+    }
+
+    _nodes.emplace_back();
+    _edges.push_back(0);
+    _nodes[0].prefix = root.prefix;
+
+    deque<pair<const BuildNode*, uint32_t>> pending;
+    pending.emplace_back(&root, 0);
+    while (!pending.empty()) {
+        const BuildNode* bnode = pending.front().first;
+        const uint32_t idx = pending.front().second;
+        pending.pop_front();
+
+        _nodes[idx].firstChild = static_cast<uint32_t>(_nodes.size());
+        _nodes[idx].numChildren = static_cast<uint32_t>(bnode->children.size());
+        for (const auto& edge : bnode->children) {
+            Node node;
+            node.runOffset = static_cast<uint32_t>(_runs.size());
+            const BuildNode* child = edge.second.get();
+            while (child->prefix == npos && child->children.size() == 1) {
+                const auto& next = *child->children.begin();
+                _runs.push_back(static_cast<char>(next.first));
+                child = next.second.get();
+            }
+            node.runLength = static_cast<uint32_t>(_runs.size() - node.runOffset);
+            node.prefix = child->prefix;
+
+            pending.emplace_back(child, static_cast<uint32_t>(_nodes.size()));
+            _nodes.push_back(node);
+            _edges.push_back(edge.first);
+        }
+    }
+}
+
+
+// Follow the trie as far as s allows, remembering the last node that ends a prefix.
+size_t PrefixMatcher::find(stringview_t s, bool longest) const noexcept {
+    size_t match = _nodes[0].prefix;
+    if (match != npos && !longest) {
+        return match;
+    }
+
+    const char* p = s.data();
+    const char* last = p + s.size();
+    const Node* node = &_nodes[0];
+    while (p < last && node->numChildren > 0) {
+        const auto c = static_cast<unsigned char>(*p);
+        const unsigned char* first = _edges.data() + node->firstChild;
+        const unsigned char* end = first + node->numChildren;
+        const unsigned char* e = (node->numChildren <= maxLinearSearch
+                                  ? std::find(first, end, c)
+                                  : lower_bound(first, end, c));
+        if (e == end || *e != c) {
+            break;
+        }
+
+        node = &_nodes[size_t(e - _edges.data())];
+        ++p;
+        if (node->runLength > 0) {
+            if (size_t(last - p) < node->runLength
+                || memcmp(p, _runs.data() + node->runOffset, node->runLength) != 0)
+            {
+                break;
+            }
+            p += node->runLength;
+        }
+
+        if (node->prefix != npos) {
+            match = node->prefix;
+            if (!longest) {
+                break;
+            }
+        }
+    }
+    return match;
+}
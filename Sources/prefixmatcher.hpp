@@ -0,0 +1,97 @@
+//
+//  prefixmatcher.hpp
+//  kssutil
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+
+/*!
+ \file
+ \brief Precomputed set of prefixes.
+ */
+
+#ifndef kssutil_prefixmatcher_hpp
+#define kssutil_prefixmatcher_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include "stringview.hpp"
+
+namespace kss { namespace util { namespace strings {
+
+    /*!
+     \brief Precomputed set of prefixes.
+
+     A PrefixMatcher is built once from a list of prefixes and may then be used to
+     determine which of them a string starts with, replacing a loop calling
+     startsWith() for each prefix. The time taken by a search depends on the length
+     of the matching prefix rather than the number of prefixes.
+
+     The prefixes are stored as a compressed trie in a few contiguous arrays. Each
+     node holds the run of characters that all of the prefixes below it share, so a
+     table of URL paths such as "/api/v1/users" and "/api/v1/orders" compares the
+     common "/api/v1/" with a single memcmp. Prefixes may contain any characters,
+     including NUL.
+     */
+    class PrefixMatcher {
+    public:
+        /*!
+         Returned by longestMatch() when no prefix matches.
+         */
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        /*!
+         Construct the matcher from a list of prefixes. The prefixes are copied, so
+         they need not outlive the matcher. If a prefix is repeated, only its first
+         occurrence is reported by longestMatch().
+         @throws std::bad_alloc if the trie could not be allocated
+         */
+        explicit PrefixMatcher(const std::vector<std::string>& prefixes = std::vector<std::string>());
+        PrefixMatcher(std::initializer_list<stringview_t> prefixes);
+
+        /*!
+         Returns the number of prefixes, including any repeats, and true if there
+         are none.
+         */
+        size_t size() const noexcept    { return _numPrefixes; }
+        bool empty() const noexcept     { return (_numPrefixes == 0); }
+
+        /*!
+         Returns true if s starts with at least one of the prefixes.
+         */
+        bool matches(stringview_t s) const noexcept { return (find(s, false) != npos); }
+
+        /*!
+         Returns the index, in the list given to the constructor, of the longest
+         prefix that s starts with, or npos if it starts with none of them.
+         */
+        size_t longestMatch(stringview_t s) const noexcept { return find(s, true); }
+
+    private:
+        struct Node {
+            uint32_t    firstChild = 0;     // the children are contiguous in _nodes
+            uint32_t    numChildren = 0;
+            uint32_t    runOffset = 0;      // characters, in _runs, following the edge
+            uint32_t    runLength = 0;
+            size_t      prefix = npos;      // index of the prefix ending here
+        };
+
+        std::vector<Node>           _nodes;
+        std::vector<unsigned char>  _edges;     // _edges[i] is the first character of node i
+        std::string                 _runs;
+        size_t                      _numPrefixes = 0;
+
+        template <class InputIterator>
+        void build(InputIterator first, InputIterator last);
+        size_t find(stringview_t s, bool longest) const noexcept;
+    };
+
+}}}
+
+#endif
@@ -16,12 +16,15 @@
 #define kssutil_sequentialmap_hpp
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <iterator>
 #include <limits>
 #include <map>
 #include <memory>
+#include <numeric>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -30,6 +33,308 @@
 
 namespace kss { namespace util { namespace containers {
 
+    namespace _private {
+        template <class... Ts> struct MakeVoid { using type = void; };
+
+        // Used to determine if a comparison or hash function object has an
+        // is_transparent member type.
+        template <class T, class = void>
+        struct IsTransparent : std::false_type {};
+
+        template <class T>
+        struct IsTransparent<T, typename MakeVoid<typename T::is_transparent>::type> : std::true_type {};
+    }
+
+    /*!
+     \brief SequentialMap index based on a std::map.
+
+     This is the default index used by SequentialMap. It maps each key to the position
+     of its element in the SequentialMap's vector using a std::map, giving O(log n)
+     lookups and one node allocation per entry.
+
+     An index must provide the same methods as this class. The find, insert and erase
+     methods are passed the vector so that an index may compare keys by looking at
+     the elements it refers to rather than storing its own copy of the keys.
+
+     An index must also provide a transparent constant that is true if its find method
+     may be called with types other than Key. For the TreeIndex this is the case when
+     Compare has an is_transparent member type (e.g. std::less<>).
+     */
+    template <class Key, class Compare = std::less<Key>,
+        class Alloc = std::allocator<std::pair<const Key, size_t> > >
+    class TreeIndex {
+    public:
+        using allocator_type = Alloc;
+        static constexpr bool transparent = _private::IsTransparent<Compare>::value;
+
+        // Returns true and sets idx if k is found.
+        template <class K, class Vec>
+        bool find(const K& k, const Vec&, size_t& idx) const {
+            auto it = _map.find(k);
+            if (it == _map.end()) {
+                return false;
+            }
+            idx = it->second;
+            return true;
+        }
+
+        // Add k, which must not already be in the index, at position idx.
+        template <class Vec>
+        void insert(const Key& k, size_t idx, const Vec&) {
+            _map.insert(std::make_pair(k, idx));
+        }
+
+        // Add vec[first] through the end of vec, recording the positions of any whose
+        // keys are already in the index, or appear earlier in the range, in dupes. The
+        // new keys are sorted first so that they can be added with correct hints,
+        // making this O(n) when the index starts empty. If an exception is thrown the
+        // index is left unchanged.
+        template <class Vec>
+        void insert_range(size_t first, const Vec& vec, std::vector<size_t>& dupes) {
+            std::vector<size_t> order(vec.size() - first);
+            std::iota(order.begin(), order.end(), first);
+            const Compare comp = _map.key_comp();
+            std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+                return comp(vec[a].first, vec[b].first);
+            });
+
+            size_t i = 0;
+            try {
+                auto hint = _map.end();
+                for (const size_t n = order.size(); i < n; ++i) {
+                    const size_t pos = order[i];
+                    if (i > 0 && !comp(vec[order[i-1]].first, vec[pos].first)) {
+                        dupes.push_back(pos);
+                        continue;
+                    }
+                    auto it = _map.emplace_hint(hint, vec[pos].first, pos);
+                    if (it->second != pos) {
+                        dupes.push_back(pos);
+                    }
+                    hint = std::next(it);
+                }
+            }
+            catch (...) {
+                for (size_t j = 0; j < i; ++j) {
+                    auto it = _map.find(vec[order[j]].first);
+                    if (it != _map.end() && it->second >= first) {
+                        _map.erase(it);
+                    }
+                }
+                throw;
+            }
+        }
+
+        // Remove k, which must still be in vec.
+        template <class Vec>
+        void erase(const Key& k, const Vec&) {
+            _map.erase(k);
+        }
+
+        // Change each position p to newPos[p]. Used after the vector has been compacted.
+        void remap(const std::vector<size_t>& newPos) noexcept {
+            for (auto& p : _map) {
+                p.second = newPos[p.second];
+            }
+        }
+
+        // Prepare for n entries. This is a no-op as a std::map cannot preallocate.
+        void reserve(size_t) noexcept                   {}
+
+        size_t size() const noexcept                    { return _map.size(); }
+        size_t max_size() const noexcept                { return _map.max_size(); }
+        void clear() noexcept                           { _map.clear(); }
+        void swap(TreeIndex& x)                         { _map.swap(x._map); }
+        allocator_type get_allocator() const noexcept   { return _map.get_allocator(); }
+
+    private:
+        std::map<Key, size_t, Compare, Alloc> _map;
+    };
+
+    template <class Key, class Compare, class Alloc>
+    constexpr bool TreeIndex<Key, Compare, Alloc>::transparent;
+
+
+    /*!
+     \brief SequentialMap index based on an open addressing hash table.
+
+     This index gives average O(1) lookups. It uses linear probing over a power of two
+     sized table. Each slot stores only the position of the element in the
+     SequentialMap's vector and the hash of its key, so there is no per-entry
+     allocation and no second copy of the keys. Keys are compared by looking them up in
+     the vector, but only when the full hashes match. Erasures use backward shift
+     deletion so that there are no tombstones, and the table is grown whenever it
+     becomes more than 75% full.
+
+     The index is transparent when both Hash and KeyEqual have an is_transparent
+     member type (e.g. strings::StringHash and std::equal_to<>). Note that in that case
+     Hash must give the same result for a key and any equivalent value.
+     */
+    template <class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+        class Alloc = std::allocator<size_t> >
+    class HashIndex {
+    public:
+        using allocator_type = Alloc;
+        static constexpr bool transparent = (_private::IsTransparent<Hash>::value
+                                             && _private::IsTransparent<KeyEqual>::value);
+
+        explicit HashIndex(const Alloc& alloc = Alloc()) : _slots(slot_allocator(alloc)) {}
+
+        template <class K, class Vec>
+        bool find(const K& k, const Vec& vec, size_t& idx) const {
+            size_t pos = 0;
+            if (!findSlot(k, _hash(k), vec, pos)) {
+                return false;
+            }
+            idx = _slots[pos].index - 1;
+            return true;
+        }
+
+        template <class Vec>
+        void insert(const Key& k, size_t idx, const Vec&) {
+            if ((_size + 1) * 4 > _slots.size() * 3) {
+                rehash(std::max(size_t(16), _slots.size() * 2));
+            }
+            place(Slot { idx + 1, _hash(k) });
+            ++_size;
+        }
+
+        // The table is grown once, before any of the range is added.
+        template <class Vec>
+        void insert_range(size_t first, const Vec& vec, std::vector<size_t>& dupes) {
+            reserve(_size + (vec.size() - first));
+            size_t i = first;
+            try {
+                for (const size_t n = vec.size(); i < n; ++i) {
+                    const size_t hash = _hash(vec[i].first);
+                    size_t pos = 0;
+                    if (findSlot(vec[i].first, hash, vec, pos)) {
+                        dupes.push_back(i);
+                    }
+                    else {
+                        _slots[pos] = Slot { i + 1, hash };
+                        ++_size;
+                    }
+                }
+            }
+            catch (...) {
+                // Since duplicates are never added, each key is in the index at most once.
+                for (size_t j = first; j < i; ++j) {
+                    size_t idx = 0;
+                    if (find(vec[j].first, vec, idx) && idx >= first) {
+                        erase(vec[j].first, vec);
+                    }
+                }
+                throw;
+            }
+        }
+
+        template <class Vec>
+        void erase(const Key& k, const Vec& vec) {
+            size_t hole = 0;
+            if (!findSlot(k, _hash(k), vec, hole)) {
+                return;
+            }
+
+            // Backward shift deletion: move any following entries that would no longer
+            // be reachable into the hole.
+            const size_t mask = _slots.size() - 1;
+            for (size_t next = (hole + 1) & mask; _slots[next].index != 0; next = (next + 1) & mask) {
+                const size_t home = homeOf(_slots[next].hash);
+                if (((next - home) & mask) >= ((next - hole) & mask)) {
+                    _slots[hole] = _slots[next];
+                    hole = next;
+                }
+            }
+            _slots[hole].index = 0;
+            --_size;
+        }
+
+        void remap(const std::vector<size_t>& newPos) noexcept {
+            for (auto& slot : _slots) {
+                if (slot.index != 0) {
+                    slot.index = newPos[slot.index - 1] + 1;
+                }
+            }
+        }
+
+        // Grow the table, if necessary, so that n entries can be added without
+        // rehashing.
+        void reserve(size_t n) {
+            size_t numSlots = 16;
+            while (numSlots * 3 < n * 4) {
+                numSlots *= 2;
+            }
+            if (numSlots > _slots.size()) {
+                rehash(numSlots);
+            }
+        }
+
+        size_t size() const noexcept                    { return _size; }
+        size_t max_size() const noexcept                { return _slots.max_size() / 2; }
+        void clear() noexcept                           { _slots.clear(); _size = 0; }
+        void swap(HashIndex& x)                         { _slots.swap(x._slots); std::swap(_size, x._size); }
+        allocator_type get_allocator() const noexcept   { return allocator_type(_slots.get_allocator()); }
+
+    private:
+        struct Slot {
+            size_t index;   // 1 + the position in the vector, 0 for an empty slot
+            size_t hash;
+        };
+        using slot_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Slot>;
+
+        std::vector<Slot, slot_allocator>   _slots;
+        size_t                              _size = 0;
+        Hash                                _hash;
+        KeyEqual                            _equal;
+
+        // Scramble the hash so that poor hash functions (e.g. the identity hash that
+        // std::hash uses for integers) still spread out over the table.
+        size_t homeOf(size_t hash) const noexcept {
+            uint64_t h = uint64_t(hash) * UINT64_C(0x9E3779B97F4A7C15);
+            h ^= (h >> 32);
+            return size_t(h) & (_slots.size() - 1);
+        }
+
+        template <class K, class Vec>
+        bool findSlot(const K& k, size_t hash, const Vec& vec, size_t& pos) const {
+            if (_slots.empty()) {
+                return false;
+            }
+            const size_t mask = _slots.size() - 1;
+            for (pos = homeOf(hash); _slots[pos].index != 0; pos = (pos + 1) & mask) {
+                const Slot& slot = _slots[pos];
+                if (slot.hash == hash && _equal(vec[slot.index - 1].first, k)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void place(const Slot& s) noexcept {
+            const size_t mask = _slots.size() - 1;
+            size_t pos = homeOf(s.hash);
+            while (_slots[pos].index != 0) {
+                pos = (pos + 1) & mask;
+            }
+            _slots[pos] = s;
+        }
+
+        void rehash(size_t numSlots) {
+            std::vector<Slot, slot_allocator> old(numSlots, Slot { 0, 0 }, _slots.get_allocator());
+            old.swap(_slots);
+            for (const auto& slot : old) {
+                if (slot.index != 0) {
+                    place(slot);
+                }
+            }
+        }
+    };
+
+    template <class Key, class Hash, class KeyEqual, class Alloc>
+    constexpr bool HashIndex<Key, Hash, KeyEqual, Alloc>::transparent;
+
+
     /*!
       \brief Combination of a list and a map
 
@@ -37,16 +342,33 @@ namespace kss { namespace util { namespace containers {
       be looked up quickly (via the map) but where the iterators preserve the order
       with which things are added.
 
-      Note that while lookups are efficient, and iterating is efficient, the removal
-      of items is O(n) as it combines the O(log n) of the map with the O(n) of the
-      list.
-
-      We follow the std::map API as much as is reasonably possible.
+      Erasing an item does not remove it from the list immediately. Instead it is
+      marked as dead, removed from the map, and skipped over by the iterators. Once the
+      fraction of dead items passes the compaction threshold (0.5 by default) the list
+      is compacted in a single O(n) pass, making erase O(1) amortized. Note that this
+      means the destructor of an erased item is not run until the next compaction,
+      and that a compaction invalidates all iterators.
+
+      The Index determines how keys are mapped to their positions in the list. By
+      default this is a TreeIndex, which uses Compare and MAlloc. Alternatively a
+      HashIndex may be used to obtain O(1) lookups (see HashSequentialMap), in which
+      case Compare and MAlloc are not used.
+
+      If the index is transparent (e.g. a Compare of std::less<>, or a HashIndex using
+      strings::StringHash and std::equal_to<>) then find, count and at will also
+      accept any type that can be compared with the keys, such as a const char* or a
+      strings::StringView for std::string keys, without constructing a temporary key.
+
+      We follow the std::map API as much as is reasonably possible. The main
+      difference is that the iterators are bidirectional rather than random access.
      */
     template <class Key, class T, class Compare = std::less<Key>,
         class Alloc = std::allocator<std::pair<Key, T> >,
-        class MAlloc = std::allocator<std::pair<const Key, size_t> > >
+        class MAlloc = std::allocator<std::pair<const Key, size_t> >,
+        class Index = TreeIndex<Key, Compare, MAlloc> >
     class SequentialMap {
+        template <class VT> class basic_iterator;
+
     public:
 
         // MARK: The standard type definitions.
@@ -55,16 +377,17 @@ namespace kss { namespace util { namespace containers {
         using value_type = std::pair<Key, T>;
         using key_compare = Compare;
         using allocator_type = Alloc;
-        using m_allocator_type = MAlloc;
+        using m_allocator_type = typename Index::allocator_type;
+        using index_type = Index;
         using reference = typename allocator_type::reference;
         using const_reference = typename allocator_type::const_reference;
         using pointer = typename allocator_type::pointer;
         using const_pointer = typename allocator_type::const_pointer;
-        using iterator = typename std::vector<value_type, Alloc>::iterator;
-        using const_iterator = typename std::vector<value_type, Alloc>::const_iterator;
+        using iterator = basic_iterator<value_type>;
+        using const_iterator = basic_iterator<const value_type>;
         using reverse_iterator = std::reverse_iterator<iterator>;
         using const_reverse_iterator = std::reverse_iterator<const_iterator>;
-        using difference_type = typename std::iterator_traits<iterator>::difference_type;
+        using difference_type = std::ptrdiff_t;
         using size_type = size_t;
 
         class value_compare;
@@ -77,7 +400,7 @@ namespace kss { namespace util { namespace containers {
         {
             kss::contract::postconditions({
                 KSS_EXPR(_vec.empty()),
-                KSS_EXPR(_map.empty())
+                KSS_EXPR(_index.size() == 0)
             });
         }
 
@@ -89,43 +412,57 @@ namespace kss { namespace util { namespace containers {
             insert(first, last);
 
             kss::contract::postconditions({
-                KSS_EXPR(_vec.size() == _map.size())
+                KSS_EXPR(size() == _index.size())
             });
         }
 
         SequentialMap(const SequentialMap&) = default;
-        SequentialMap(SequentialMap&&) = default;
+
+        // The moved from map is left empty but usable.
+        SequentialMap(SequentialMap&& x)
+        : _vec(std::move(x._vec)), _dead(std::move(x._dead)), _index(std::move(x._index)),
+          _numDead(x._numDead), _head(x._head), _compactionThreshold(x._compactionThreshold)
+        {
+            x.clear();
+        }
 
         ~SequentialMap() = default;
 
         SequentialMap& operator=(const SequentialMap& x) = default;
-        SequentialMap& operator=(SequentialMap&&) = default;
+
+        SequentialMap& operator=(SequentialMap&& x) {
+            if (&x != this) {
+                clear();
+                swap(x);
+            }
+            return *this;
+        }
 
         // MARK: Iterators
-        iterator                begin() noexcept         { return _vec.begin(); }
-        const_iterator          begin() const noexcept   { return _vec.begin(); }
-        iterator                end() noexcept           { return _vec.end(); }
-        const_iterator          end() const noexcept     { return _vec.end(); }
-        reverse_iterator        rbegin() noexcept        { return _vec.rbegin(); }
-        const_reverse_iterator  rbegin() const noexcept  { return _vec.rbegin(); }
-        reverse_iterator        rend() noexcept          { return _vec.rend(); }
-        const_reverse_iterator  rend() const noexcept    { return _vec.rend(); }
-        const_iterator          cbegin() const noexcept  { return _vec.begin(); }
-        const_iterator          cend() const noexcept    { return _vec.end(); }
-        const_reverse_iterator  crbegin() const noexcept { return _vec.rbegin(); }
-        const_reverse_iterator  crend() const noexcept   { return _vec.rend(); }
+        iterator                begin() noexcept         { return iterator(_vec.data()+_head, _dead.data()+_head); }
+        const_iterator          begin() const noexcept   { return const_iterator(_vec.data()+_head, _dead.data()+_head); }
+        iterator                end() noexcept           { return iterator(_vec.data()+_vec.size(), _dead.data()+_vec.size()); }
+        const_iterator          end() const noexcept     { return const_iterator(_vec.data()+_vec.size(), _dead.data()+_vec.size()); }
+        reverse_iterator        rbegin() noexcept        { return reverse_iterator(end()); }
+        const_reverse_iterator  rbegin() const noexcept  { return const_reverse_iterator(end()); }
+        reverse_iterator        rend() noexcept          { return reverse_iterator(begin()); }
+        const_reverse_iterator  rend() const noexcept    { return const_reverse_iterator(begin()); }
+        const_iterator          cbegin() const noexcept  { return begin(); }
+        const_iterator          cend() const noexcept    { return end(); }
+        const_reverse_iterator  crbegin() const noexcept { return rbegin(); }
+        const_reverse_iterator  crend() const noexcept   { return rend(); }
 
 
         // MARK: Capacity
-        bool        empty() const noexcept       { return _map.empty(); }
-        size_type   size() const noexcept        { return _map.size(); }
-        size_type   max_size() const noexcept    { return std::min(_map.max_size(), _vec.max_size()); }
+        bool        empty() const noexcept       { return (size() == 0); }
+        size_type   size() const noexcept        { return _vec.size() - _numDead; }
+        size_type   max_size() const noexcept    { return std::min(_index.max_size(), _vec.max_size()); }
 
 
         // MARK: Element access
         mapped_type& operator[](const key_type& k) {
             kss::contract::preconditions({
-                KSS_EXPR(_vec.size() == _map.size())
+                KSS_EXPR(size() == _index.size())
             });
 
             iterator it = find(k);
@@ -135,14 +472,14 @@ namespace kss { namespace util { namespace containers {
             }
 
             kss::contract::postconditions({
-                KSS_EXPR(_vec.size() == _map.size())
+                KSS_EXPR(size() == _index.size())
             });
             return it->second;
         }
 
         mapped_type& at(const key_type& k) {
             kss::contract::preconditions({
-                KSS_EXPR(_vec.size() == _map.size())
+                KSS_EXPR(size() == _index.size())
             });
 
             iterator it = find(k);
@@ -151,14 +488,14 @@ namespace kss { namespace util { namespace containers {
             }
 
             kss::contract::postconditions({
-                KSS_EXPR(_vec.size() == _map.size())
+                KSS_EXPR(size() == _index.size())
             });
             return it->second;
         }
 
         const mapped_type& at(const key_type& k) const {
             kss::contract::preconditions({
-                KSS_EXPR(_vec.size() == _map.size())
+                KSS_EXPR(size() == _index.size())
             });
 
             const_iterator it = find(k);
@@ -167,28 +504,60 @@ namespace kss { namespace util { namespace containers {
             }
 
             kss::contract::postconditions({
-                KSS_EXPR(_vec.size() == _map.size())
+                KSS_EXPR(size() == _index.size())
             });
             return it->second;
         }
 
+        template <class K, class I = Index, class = typename std::enable_if<I::transparent>::type>
+        mapped_type& at(const K& k) {
+            iterator it = find(k);
+            if (it == end()) {
+                throw std::out_of_range("the given key is not found in the map");
+            }
+            return it->second;
+        }
+
+        template <class K, class I = Index, class = typename std::enable_if<I::transparent>::type>
+        const mapped_type& at(const K& k) const {
+            const_iterator it = find(k);
+            if (it == end()) {
+                throw std::out_of_range("the given key is not found in the map");
+            }
+            return it->second;
+        }
+
 
         // MARK: Modifiers
         std::pair<iterator, bool> insert(const value_type& val) {
             kss::contract::preconditions({
-                KSS_EXPR(_vec.size() == _map.size())
+                KSS_EXPR(size() == _index.size())
             });
 
             bool wasInserted = false;
             iterator it = find(val.first);
             if (it == end()) {
-                it = _vec.insert(_vec.end(), val);
-                _map.insert(std::make_pair(val.first, _vec.size()-1));
+                const size_t pos = _vec.size();
+                if (_dead.capacity() < pos + 2) {
+                    // Grow geometrically, an exact reserve would make loading O(n^2).
+                    _dead.reserve(std::max(pos + 2, _dead.capacity() * 2));
+                }
+                _vec.push_back(val);
+                try {
+                    _index.insert(val.first, pos, _vec);
+                }
+                catch (...) {
+                    _vec.pop_back();
+                    throw;
+                }
+                _dead.push_back(0);     // the old sentinel becomes the flag for pos
+                it = iterator(_vec.data()+pos, _dead.data()+pos);
                 wasInserted = true;
             }
 
             kss::contract::postconditions({
-                KSS_EXPR(_vec.size() == _map.size())
+                KSS_EXPR(size() == _index.size()),
+                KSS_EXPR(_dead.size() == _vec.size() + 1)
             });
             return std::make_pair(it, wasInserted);
         }
@@ -197,18 +566,51 @@ namespace kss { namespace util { namespace containers {
             return insert(val).first;
         }
 
+        // Rather than inserting the items one at a time, they are all appended to the
+        // list and then added to the index in a single pass. As with the single item
+        // insert, an item whose key is already in the map (or appears earlier in the
+        // range) is not added. If an exception is thrown while adding the items the
+        // map is left unchanged.
         template <class InputIterator>
         void insert(InputIterator first, InputIterator last) {
             kss::contract::preconditions({
-                KSS_EXPR(_vec.size() == _map.size())
+                KSS_EXPR(size() == _index.size())
             });
 
-            for (InputIterator it = first; it != last; ++it) {
-                insert(*it);
+            const size_t oldSize = _vec.size();
+            std::vector<size_t> dupes;
+            try {
+                reserveForRange(first, last, typename std::iterator_traits<InputIterator>::iterator_category());
+                for (InputIterator it = first; it != last; ++it) {
+                    _vec.emplace_back(*it);
+                }
+                _dead.resize(_vec.size() + 1, 0);
+                if (_vec.size() > oldSize) {
+                    _index.insert_range(oldSize, _vec, dupes);
+                }
+            }
+            catch (...) {
+                _vec.erase(_vec.begin() + difference_type(oldSize), _vec.end());
+                _dead.resize(oldSize + 1);
+                throw;
+            }
+
+            // The duplicates are treated as erased items, leaving the map in a valid
+            // state even if the compaction should fail.
+            if (!dupes.empty()) {
+                for (size_t pos : dupes) {
+                    _dead[pos] = 1;
+                }
+                _numDead += dupes.size();
+                while (_head < _vec.size() && _dead[_head]) {
+                    ++_head;
+                }
+                compact();
             }
 
             kss::contract::postconditions({
-                KSS_EXPR(_vec.size() == _map.size())
+                KSS_EXPR(size() == _index.size()),
+                KSS_EXPR(_dead.size() == _vec.size() + 1)
             });
         }
 
@@ -216,12 +618,12 @@ namespace kss { namespace util { namespace containers {
         // the map or are not in the correct order. This differs from
         // map::erase where the behaviour is undefined.
         void erase(iterator position) {
-            erase(position, position+1);
+            erase(position, std::next(position));
         }
 
         size_type erase(const key_type& k) {
             kss::contract::preconditions({
-                KSS_EXPR(_vec.size() == _map.size())
+                KSS_EXPR(size() == _index.size())
             });
 
             size_type numErased { 0 };
@@ -232,7 +634,7 @@ namespace kss { namespace util { namespace containers {
             }
 
             kss::contract::postconditions({
-                KSS_EXPR(_vec.size() == _map.size())
+                KSS_EXPR(size() == _index.size())
             });
             return numErased;
         }
@@ -242,51 +644,113 @@ namespace kss { namespace util { namespace containers {
         // map::erase where the behaviour is undefined.
         void erase(iterator first, iterator last) {
             kss::contract::preconditions({
-                KSS_EXPR(first >= begin()),
-                KSS_EXPR(last >= first),
-                KSS_EXPR(_vec.size() == _map.size())
+                KSS_EXPR(size() == _index.size())
             });
 
-            difference_type i = first - begin();
-            difference_type n = last - first;
-            if (i < 0 || n < 0) {
+            const pointer data = _vec.data();
+            if (first._ptr < data || last._ptr < first._ptr || last._ptr > data + _vec.size()) {
                 throw std::invalid_argument("iterator(s) are not valid for this SequentialMap");
             }
 
-            // Need to remove the items from both _vec and _map, then reduce
-            // the indices in _map for all items >= i by n.
+            // Mark the items as dead and remove them from the index. The positions of
+            // the remaining items do not change until we compact.
             for (iterator it = first; it != last; ++it) {
-                _map.erase(it->first);
+                _index.erase(it->first, _vec);
+                _dead[size_t(it._ptr - data)] = 1;
+                ++_numDead;
             }
-            _vec.erase(first, last);
-            for (typename std::map<Key, size_t, Compare, MAlloc>::iterator it = _map.begin(), stop = _map.end(); it != stop; ++it) {
-                if (it->second >= size_type(i)) {
-                    it->second -= size_type(n);
-                }
+            while (_head < _vec.size() && _dead[_head]) {
+                ++_head;
+            }
+            // Also compact once every item is dead, as otherwise a threshold of 1 would
+            // never compact.
+            if (double(_numDead) > _compactionThreshold * double(_vec.size()) || _numDead == _vec.size()) {
+                compact();
             }
 
             kss::contract::postconditions({
-                KSS_EXPR(_vec.size() == _map.size())
+                KSS_EXPR(size() == _index.size())
             });
         }
 
         void swap(SequentialMap& x) {
             _vec.swap(x._vec);
-            _map.swap(x._map);
+            _dead.swap(x._dead);
+            _index.swap(x._index);
+            std::swap(_numDead, x._numDead);
+            std::swap(_head, x._head);
+            std::swap(_compactionThreshold, x._compactionThreshold);
 
             kss::contract::postconditions({
-                KSS_EXPR(_vec.size() == _map.size()),
-                KSS_EXPR(x._vec.size() == x._map.size())
+                KSS_EXPR(size() == _index.size()),
+                KSS_EXPR(x.size() == x._index.size())
             });
         }
 
         void clear() noexcept {
             _vec.clear();
-            _map.clear();
+            _dead.assign(1, 0);
+            _index.clear();
+            _numDead = _head = 0;
 
             kss::contract::postconditions({
                 KSS_EXPR(_vec.empty()),
-                KSS_EXPR(_map.empty())
+                KSS_EXPR(_index.size() == 0)
+            });
+        }
+
+        /*!
+         Preallocate enough space for n items, counting any erased items that have
+         not yet been compacted, so that they can be added without reallocating the
+         list or rehashing the index.
+         @throws std::length_error if n > max_size()
+         */
+        void reserve(size_type n) {
+            _vec.reserve(n + _numDead);
+            _dead.reserve(n + _numDead + 1);
+            _index.reserve(n);
+        }
+
+        /*!
+         Compaction. Erased items are removed from the list once more than
+         compaction_threshold() of the list is dead, or once all of it is. The threshold
+         must be in the range [0,1], where 0 compacts on every erase and 1 only compacts
+         once every item has been erased. Calling compact() will remove any dead items immediately. Any
+         compaction invalidates all iterators.
+         @throws std::invalid_argument if the threshold is out of range.
+         */
+        double compaction_threshold() const noexcept { return _compactionThreshold; }
+
+        void set_compaction_threshold(double threshold) {
+            kss::contract::parameters({
+                KSS_EXPR(threshold >= 0.0 && threshold <= 1.0)
+            });
+            _compactionThreshold = threshold;
+        }
+
+        void compact() {
+            if (_numDead == 0) {
+                return;
+            }
+
+            std::vector<size_t> newPos(_vec.size());
+            size_t j = 0;
+            for (size_t i = 0, n = _vec.size(); i < n; ++i) {
+                if (!_dead[i]) {
+                    if (i != j) {
+                        _vec[j] = std::move(_vec[i]);
+                    }
+                    newPos[i] = j++;
+                }
+            }
+            _vec.erase(_vec.begin() + difference_type(j), _vec.end());
+            _dead.assign(j + 1, 0);
+            _index.remap(newPos);
+            _numDead = _head = 0;
+
+            kss::contract::postconditions({
+                KSS_EXPR(_vec.size() == _index.size()),
+                KSS_EXPR(_dead.size() == _vec.size() + 1)
             });
         }
 
@@ -294,64 +758,78 @@ namespace kss { namespace util { namespace containers {
         // MARK: Observers
         key_compare         key_comp() const                 { return Compare(); }
         value_compare       value_comp() const               { return value_compare(Compare()); }
-        allocator_type      get_allocator() const noexcept   { _vec.get_allocator(); }
-        m_allocator_type    get_m_allocator() const noexcept { _map.get_allocator(); }
+        allocator_type      get_allocator() const noexcept   { return _vec.get_allocator(); }
+        m_allocator_type    get_m_allocator() const noexcept { return _index.get_allocator(); }
 
 
         // MARK: Operations
         iterator find(const key_type& k) {
             kss::contract::preconditions({
-                KSS_EXPR(_vec.size() == _map.size())
+                KSS_EXPR(size() == _index.size())
             });
 
-            iterator retIt = end();
-            typename std::map<Key, size_t, Compare, MAlloc>::iterator it = _map.find(k);
-            if (it != _map.end()) {
-                size_t maxIncr = std::numeric_limits<difference_type>::max();
-                size_t remain = it->second;
-                retIt = _vec.begin();
-                while (remain > maxIncr) {
-                    retIt += difference_type(maxIncr);
-                    remain -= maxIncr;
-                }
-                retIt += difference_type(remain);
+            size_t idx = 0;
+            if (_index.find(k, _vec, idx)) {
+                return iterator(_vec.data()+idx, _dead.data()+idx);
             }
+            return end();
+        }
 
-            kss::contract::postconditions({
-                KSS_EXPR(_vec.size() == _map.size())
+        const_iterator find(const key_type& k) const {
+            kss::contract::preconditions({
+                KSS_EXPR(size() == _index.size())
             });
-            return retIt;
+
+            size_t idx = 0;
+            if (_index.find(k, _vec, idx)) {
+                return const_iterator(_vec.data()+idx, _dead.data()+idx);
+            }
+            return end();
         }
 
-        const_iterator find(const key_type& k) const {
+        size_type count(const key_type& k) const {
+            kss::contract::preconditions({
+                KSS_EXPR(size() == _index.size())
+            });
+            size_t idx = 0;
+            return (_index.find(k, _vec, idx) ? 1 : 0);
+        }
+
+        // Transparent versions of the above. These are only available if the index
+        // is transparent.
+        template <class K, class I = Index, class = typename std::enable_if<I::transparent>::type>
+        iterator find(const K& k) {
             kss::contract::preconditions({
-                KSS_EXPR(_vec.size() == _map.size())
+                KSS_EXPR(size() == _index.size())
             });
 
-            const_iterator retIt = end();
-            typename std::map<Key, size_t, Compare, MAlloc>::const_iterator it = _map.find(k);
-            if (it != _map.end()) {
-                size_t maxIncr = std::numeric_limits<difference_type>::max();
-                size_t remain = it->second;
-                retIt = _vec.begin();
-                while (remain > maxIncr) {
-                    retIt += difference_type(maxIncr);
-                    remain -= maxIncr;
-                }
-                retIt += difference_type(remain);
+            size_t idx = 0;
+            if (_index.find(k, _vec, idx)) {
+                return iterator(_vec.data()+idx, _dead.data()+idx);
             }
+            return end();
+        }
 
-            kss::contract::postconditions({
-                KSS_EXPR(_vec.size() == _map.size())
+        template <class K, class I = Index, class = typename std::enable_if<I::transparent>::type>
+        const_iterator find(const K& k) const {
+            kss::contract::preconditions({
+                KSS_EXPR(size() == _index.size())
             });
-            return retIt;
+
+            size_t idx = 0;
+            if (_index.find(k, _vec, idx)) {
+                return const_iterator(_vec.data()+idx, _dead.data()+idx);
+            }
+            return end();
         }
 
-        size_type count(const key_type& k) const {
+        template <class K, class I = Index, class = typename std::enable_if<I::transparent>::type>
+        size_type count(const K& k) const {
             kss::contract::preconditions({
-                KSS_EXPR(_vec.size() == _map.size())
+                KSS_EXPR(size() == _index.size())
             });
-            return (_map.find(k) == _map.end() ? 0 : 1);
+            size_t idx = 0;
+            return (_index.find(k, _vec, idx) ? 1 : 0);
         }
 
         class value_compare {
@@ -367,18 +845,88 @@ namespace kss { namespace util { namespace containers {
         };
 
     private:
-        std::vector<std::pair<Key, T>, Alloc>   _vec;
-        std::map<Key, size_t, Compare, MAlloc>  _map;
+        // Bidirectional iterator that skips over the dead items. It relies on there
+        // being one more flag than items, with the extra one never dead, so that
+        // incrementing will always stop at end().
+        template <class VT>
+        class basic_iterator : public std::iterator<std::bidirectional_iterator_tag, VT> {
+        public:
+            basic_iterator() = default;
+
+            // Allows an iterator to be converted to a const_iterator.
+            template <class OVT, class = typename std::enable_if<std::is_convertible<OVT*, VT*>::value>::type>
+            basic_iterator(const basic_iterator<OVT>& it) noexcept : _ptr(it._ptr), _dead(it._dead) {}
+
+            VT& operator*() const noexcept  { return *_ptr; }
+            VT* operator->() const noexcept { return _ptr; }
+
+            basic_iterator& operator++() noexcept {
+                do { ++_ptr; ++_dead; } while (*_dead);
+                return *this;
+            }
+            basic_iterator operator++(int) noexcept {
+                basic_iterator tmp(*this);
+                operator++();
+                return tmp;
+            }
+            basic_iterator& operator--() noexcept {
+                do { --_ptr; --_dead; } while (*_dead);
+                return *this;
+            }
+            basic_iterator operator--(int) noexcept {
+                basic_iterator tmp(*this);
+                operator--();
+                return tmp;
+            }
+
+            bool operator==(const basic_iterator& rhs) const noexcept { return _ptr == rhs._ptr; }
+            bool operator!=(const basic_iterator& rhs) const noexcept { return _ptr != rhs._ptr; }
+
+        private:
+            friend class SequentialMap;
+            template <class OVT> friend class basic_iterator;
+
+            basic_iterator(VT* ptr, const unsigned char* dead) noexcept : _ptr(ptr), _dead(dead) {}
+
+            VT*                     _ptr = nullptr;
+            const unsigned char*    _dead = nullptr;
+        };
+
+        // Preallocate for a range if we can determine its size without consuming it.
+        template <class InputIterator>
+        void reserveForRange(InputIterator, InputIterator, std::input_iterator_tag) {}
+
+        template <class ForwardIterator>
+        void reserveForRange(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+            reserve(size() + size_t(std::distance(first, last)));
+        }
+
+        using flag_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<unsigned char>;
+
+        std::vector<std::pair<Key, T>, Alloc>       _vec;
+        std::vector<unsigned char, flag_allocator>  _dead = std::vector<unsigned char, flag_allocator>(1, 0);
+        Index                                       _index;
+        size_t                                      _numDead = 0;
+        size_t                                      _head = 0;      // position of the first live item
+        double                                      _compactionThreshold = 0.5;
     };
 
 
-    template <class Key, class T, class Compare, class Alloc, class MAlloc>
-    inline void swap(SequentialMap<Key, T, Compare, Alloc, MAlloc>& x,
-                     SequentialMap<Key, T, Compare, Alloc, MAlloc>& y)
+    template <class Key, class T, class Compare, class Alloc, class MAlloc, class Index>
+    inline void swap(SequentialMap<Key, T, Compare, Alloc, MAlloc, Index>& x,
+                     SequentialMap<Key, T, Compare, Alloc, MAlloc, Index>& y)
     {
         x.swap(y);
     }
 
+    /*!
+     A SequentialMap that uses a HashIndex for O(1) lookups.
+     */
+    template <class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+        class Alloc = std::allocator<std::pair<Key, T> > >
+    using HashSequentialMap = SequentialMap<Key, T, std::less<Key>, Alloc,
+        std::allocator<std::pair<const Key, size_t> >, HashIndex<Key, Hash, KeyEqual> >;
+
 }}}
 
 #endif
@@ -0,0 +1,142 @@
+//
+//  streamtokenizer.cpp
+//  kssutil
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+
+#include <unistd.h>
+
+#include <kss/contract/all.h>
+
+#include "streamtokenizer.hpp"
+
+using namespace std;
+using namespace kss::util::strings;
+
+namespace contract = kss::contract;
+
+constexpr size_t StreamTokenizer::defaultChunkSize;
+
+
+StreamTokenizer::StreamTokenizer(istream& strm, const string& delim, size_t chunkSize)
+: _strm(&strm), _delim(delim)
+{
+    contract::parameters({
+        KSS_EXPR(!delim.empty()),
+        KSS_EXPR(chunkSize > 0)
+    });
+
+    _buf.resize(chunkSize);
+
+    contract::postconditions({
+        KSS_EXPR(!_delim.empty()),
+        KSS_EXPR(_buf.size() == chunkSize)
+    });
+}
+
+StreamTokenizer::StreamTokenizer(int fd, const string& delim, size_t chunkSize)
+: _fd(fd), _delim(delim)
+{
+    contract::parameters({
+        KSS_EXPR(!delim.empty()),
+        KSS_EXPR(chunkSize > 0)
+    });
+
+    _buf.resize(chunkSize);
+
+    contract::postconditions({
+        KSS_EXPR(!_delim.empty()),
+        KSS_EXPR(_buf.size() == chunkSize)
+    });
+}
+
+
+bool StreamTokenizer::hasAnother() {
+    if (_pos == _len && !_eof) {
+        _pos = _len = 0;
+        fill();
+    }
+    return (_pos < _len || _afterDelimiter);
+}
+
+// Obtain the next token. If the data in the buffer does not contain a delimiter
+// we shift the partial token to the start of the buffer and read more, growing
+// the buffer only if the partial token already fills it.
+stringview_t& StreamTokenizer::next(stringview_t& token) {
+    contract::preconditions({
+        KSS_EXPR(hasAnother() == true)
+    });
+
+    size_t searched = _pos;
+    while (true) {
+        const char* first = _buf.data();
+        const char* p = _delim.find(first + searched, first + _len);
+        if (p != first + _len) {
+            const size_t pos = size_t(p - first);
+            token = stringview_t(first + _pos, pos - _pos);
+            _pos = pos + 1;
+            _afterDelimiter = true;
+            return token;
+        }
+
+        if (_eof) {
+            // final token, which may be empty
+            token = stringview_t(first + _pos, _len - _pos);
+            _pos = _len;
+            _afterDelimiter = false;
+            return token;
+        }
+
+        if (_pos > 0) {
+            copy(_buf.begin() + ptrdiff_t(_pos), _buf.begin() + ptrdiff_t(_len), _buf.begin());
+            _len -= _pos;
+            _pos = 0;
+        }
+        else if (_len == _buf.size()) {
+            _buf.resize(_buf.size() * 2);
+        }
+        searched = _len;
+        fill();
+    }
+}
+
+string& StreamTokenizer::next(string& token) {
+    stringview_t sv;
+    next(sv);
+    token.assign(sv.data(), sv.size());
+    return token;
+}
+
+
+// Read as much as will fit into the buffer, returning the number of bytes read. A
+// return of zero means we have reached the end of the input.
+size_t StreamTokenizer::fill() {
+    size_t n = 0;
+    if (_strm) {
+        _strm->read(_buf.data() + _len, streamsize(_buf.size() - _len));
+        n = size_t(_strm->gcount());
+    }
+    else {
+        ssize_t ret = 0;
+        do {
+            ret = ::read(_fd, _buf.data() + _len, _buf.size() - _len);
+        } while (ret == -1 && errno == EINTR);
+        if (ret == -1) {
+            throw system_error(errno, system_category(), "read");
+        }
+        n = size_t(ret);
+    }
+
+    if (n == 0) {
+        _eof = true;
+    }
+    _len += n;
+    return n;
+}
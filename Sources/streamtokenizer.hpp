@@ -0,0 +1,125 @@
+//
+//  streamtokenizer.hpp
+//  kssutil
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+
+/*!
+ \file
+ \brief Token based splitting of streams and files.
+ */
+
+#ifndef kssutil_streamtokenizer_hpp
+#define kssutil_streamtokenizer_hpp
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "delimiterset.hpp"
+#include "iterator.hpp"
+#include "stringview.hpp"
+
+namespace kss { namespace util { namespace strings {
+
+    /*!
+     \brief Tokenizer that reads its input in chunks.
+
+     This provides the same tokens as a Tokenizer, but rather than requiring the
+     entire input as a string, it reads it from a std::istream or a file descriptor
+     a chunk at a time. Tokens that span the end of a chunk are handled by moving the
+     partial token to the start of the buffer before reading more, and the buffer is
+     only grown if a single token does not fit. Hence the memory used is bounded by
+     the chunk size and the length of the longest token, not the size of the input.
+
+     Each token is returned as a stringview_t referring to the internal buffer, so
+     that no memory is allocated per token. The view is only valid until the next
+     call to hasAnother() or next(). Use next(std::string&) if you need to keep it.
+
+     For input that is already in memory, such as a memory mapped file, use a
+     ViewTokenizer on that memory instead.
+
+     The tokenizer does not take ownership of the stream or file descriptor, both of
+     which must remain valid while the tokenizer is in use.
+     */
+    class StreamTokenizer {
+    public:
+        /*!
+         Container/iterator based type definitions.
+         */
+        using value_type = stringview_t;
+        using iterator = kss::util::iterators::ForwardIterator<StreamTokenizer, stringview_t>;
+
+        /*!
+         The chunk size used if none is specified.
+         */
+        static constexpr size_t defaultChunkSize = 64 * 1024;
+
+        /*!
+         Create the tokenizer for a given input and delimiter set. Note that having two
+         or more delimiters in a row will lead to empty tokens.
+
+         @param strm is the stream to be read
+         @param fd is the file descriptor to be read
+         @param delims is the set of delimiters
+         @param chunkSize is the number of bytes to read at a time
+         @throws std::invalid_argument if delim is empty or chunkSize is 0
+         @throws std::bad_alloc if the buffer could not be allocated
+         */
+        explicit StreamTokenizer(std::istream& strm,
+                                 const std::string& delims = " \t\n\r",
+                                 size_t chunkSize = defaultChunkSize);
+        explicit StreamTokenizer(int fd,
+                                 const std::string& delims = " \t\n\r",
+                                 size_t chunkSize = defaultChunkSize);
+        ~StreamTokenizer() noexcept = default;
+
+        StreamTokenizer(const StreamTokenizer&) = delete;
+        StreamTokenizer& operator=(const StreamTokenizer&) = delete;
+
+        /*!
+         Returns true if there is another item available and false otherwise. This
+         may need to read from the input in order to determine the answer.
+         @throws std::system_error if a file descriptor could not be read
+         @throws std::ios_base::failure if the stream throws it
+         */
+        bool hasAnother();
+
+        /*!
+         Retrieves the next token and places it in token. It is invalid to call this
+         if there are no more tokens.
+         @return a reference to token
+         @throws std::system_error if a file descriptor could not be read
+         @throws std::ios_base::failure if the stream throws it
+         @throws std::bad_alloc if the buffer needed to be grown but could not be
+         */
+        stringview_t& next(stringview_t& token);
+        std::string& next(std::string& token);
+
+        /*!
+         Iterator based access. As with the Tokenizer, you should use either this or
+         the stream based access, but not both.
+         */
+        iterator begin() { return iterator(*this); }
+        iterator end()   { return iterator(); }
+
+    private:
+        std::istream*       _strm = nullptr;
+        int                 _fd = -1;
+        DelimiterSet        _delim;
+        std::vector<char>   _buf;
+        size_t              _pos = 0;               // start of the unconsumed data
+        size_t              _len = 0;               // end of the valid data
+        bool                _eof = false;
+        bool                _afterDelimiter = false;  // a token always follows a delimiter
+
+        size_t fill();
+    };
+
+}}}
+
+#endif
@@ -7,8 +7,13 @@
 //  Licensing follows the MIT License.
 //
 
+#if defined(__AVX2__)
+#   include <immintrin.h>
+#elif defined(__SSE2__)
+#   include <emmintrin.h>
+#endif
+
 #include <algorithm>
-#include <cassert>
 #include <cctype>
 #include <cerrno>
 #include <cstdarg>
@@ -18,7 +23,6 @@
 #include <cwctype>
 #include <new>
 #include <system_error>
-#include <vector>
 
 #include <kss/contract/all.h>
 
@@ -27,21 +31,51 @@
 
 using namespace std;
 using namespace kss::util;
+using kss::util::strings::stringview_t;
 namespace contract = kss::contract;
 
 
-string strings::format(string pattern, ...) {
+string strings::format(const char* pattern, ...) {
+    string s;
     va_list ap;
     va_start(ap, pattern);
-    string s = strings::vformat(pattern, ap);
-    va_end(ap);
+    Finally cleanup([&] {
+        va_end(ap);
+    });
+    vappendFormat(s, pattern, ap);
     return s;
 }
 
+string strings::format(string pattern, ...) {
+    va_list ap;
+    va_start(ap, pattern);
+    Finally cleanup([&] {
+        va_end(ap);
+    });
+    return strings::vformat(pattern, ap);
+}
+
 
 string strings::vformat(const string& pattern, va_list ap) {
+    string s;
+    vappendFormat(s, pattern.c_str(), ap);
+    return s;
+}
+
+
+string& strings::appendFormat(string& s, const char* pattern, ...) {
+    va_list ap;
+    va_start(ap, pattern);
+    Finally cleanup([&] {
+        va_end(ap);
+    });
+    return vappendFormat(s, pattern, ap);
+}
+
+
+string& strings::vappendFormat(string& s, const char* pattern, va_list ap) {
     contract::parameters({
-        KSS_EXPR(!pattern.empty())
+        KSS_EXPR(pattern != nullptr && *pattern != '\0')
     });
 
     // We need to make a copy of ap in case we have to call vsnprintf twice.
@@ -51,111 +85,263 @@ string strings::vformat(const string& pattern, va_list ap) {
         va_end(ap2);
     });
 
-    // First we try a "reasonable" string length.
-    size_t maxlen = pattern.size() + 1024;
-    vector<char> buffer(maxlen);
-
-    int requiredlen = vsnprintf(buffer.data(), maxlen, pattern.c_str(), ap);
+    // First we try a stack buffer, which is enough for most uses, and append the
+    // result to s.
+    char buffer[512];
+    const int requiredlen = vsnprintf(buffer, sizeof(buffer), pattern, ap);
     if (requiredlen < 0) {
         throw system_error(errno, system_category(), "vsnprintf");
     }
 
-    // If our original length guess was not sufficient, then we reallocate it and do the
-    // write a second time.
-    if ((size_t)requiredlen >= maxlen) {
-        maxlen = (size_t)requiredlen+1;
-        buffer.resize(maxlen);
-        vsnprintf(buffer.data(), maxlen, pattern.data(), ap2);
+    const size_t len = size_t(requiredlen);
+    if (len < sizeof(buffer)) {
+        return s.append(buffer, len);
     }
 
-    return string(buffer.data());
+    // If that was not sufficient, then we enlarge s by the required length and do
+    // the write a second time, directly into s. The vsnprintf writes a trailing '\0'
+    // which is then removed.
+    const size_t start = s.size();
+    s.resize(start + len + 1);
+    vsnprintf(&s[start], len + 1, pattern, ap2);
+    s.resize(start + len);
+    return s;
 }
 
 
 /* Trimming a string. */
+namespace {
+    inline bool isSpace(char c) noexcept {
+        return (isspace(static_cast<unsigned char>(c)) != 0);
+    }
+
+    template <class Pred>
+    stringview_t leftTrim(stringview_t s, Pred pred) noexcept {
+        size_t i = 0;
+        while (i < s.size() && pred(s[i])) { ++i; }
+        return stringview_t(s.data() + i, s.size() - i);
+    }
+
+    template <class Pred>
+    stringview_t rightTrim(stringview_t s, Pred pred) noexcept {
+        size_t len = s.size();
+        while (len > 0 && pred(s[len-1])) { --len; }
+        return stringview_t(s.data(), len);
+    }
+
+    // Reduce s to the part described by the view v, which must lie within s. The
+    // end is removed first so that at most one erase moves any characters.
+    string& keepOnly(string& s, stringview_t v) noexcept {
+        const size_t start = size_t(v.data() - s.data());
+        s.erase(start + v.size());
+        if (start > 0) { s.erase(0, start); }
+        return s;
+    }
+}
+
+strings::stringview_t strings::ltrim(stringview_t s) noexcept {
+    return leftTrim(s, isSpace);
+}
+strings::stringview_t strings::ltrim(stringview_t s, char c) noexcept {
+    return leftTrim(s, [c](char ch) { return ch == c; });
+}
+
+strings::stringview_t strings::rtrim(stringview_t s) noexcept {
+    return rightTrim(s, isSpace);
+}
+strings::stringview_t strings::rtrim(stringview_t s, char c) noexcept {
+    return rightTrim(s, [c](char ch) { return ch == c; });
+}
+
 string& strings::ltrim(string& s) noexcept {
-    size_t len = s.size();
-    size_t i = 0;
-    while (i < len && isspace(s[i])) { ++i; }
-    if (i > 0) { s.erase(0, i); }
-    return s;
+    return keepOnly(s, ltrim(stringview_t(s)));
 }
 string& strings::ltrim(string& s, char c) noexcept {
-    size_t len = s.size();
-    size_t i = 0;
-    while (i < len && s[i] == c) { ++i; }
-    if (i > 0) { s.erase(0, i); }
-    return s;
+    return keepOnly(s, ltrim(stringview_t(s), c));
 }
 
 string& strings::rtrim(string& s) noexcept {
-    size_t len = s.size();
-    size_t i = 0;
-    while (i < len && isspace(s[len-i-1])) { ++i; }
-    if (i > 0) { s.erase(len-i); }
-    return s;
+    return keepOnly(s, rtrim(stringview_t(s)));
 }
 string& strings::rtrim(string& s, char c) noexcept {
-    size_t len = s.size();
-    size_t i = 0;
-    while (i < len && s[len-i-1] == c) { ++i; }
-    if (i > 0) { s.erase(len-i); }
-    return s;
+    return keepOnly(s, rtrim(stringview_t(s), c));
 }
 
-namespace {
+string& strings::trim(string& s) noexcept {
+    return keepOnly(s, trim(stringview_t(s)));
+}
+string& strings::trim(string& s, char c) noexcept {
+    return keepOnly(s, trim(stringview_t(s), c));
+}
 
-    bool kss_starts_with(const char* str, const char* prefix) {
-        assert(str != nullptr);
-        assert(prefix != nullptr);
+bool strings::startsWith(stringview_t str, stringview_t prefix) noexcept {
+    /* All strings - even empty ones - start with an empty prefix. */
+    if (prefix.empty()) {
+        return true;
+    }
 
-        /* All strings - even empty ones - start with an empty prefix. */
-        size_t plen = strlen(prefix);
-        if (!plen) {
-            return true;
-        }
+    /* Strings shorter than the prefix cannot start with the prefix. */
+    if (str.size() < prefix.size()) {
+        return false;
+    }
 
-        /* Empty strings, or strings shorter than the prefix, cannot start with the prefix. */
-        size_t slen = strlen(str);
-        if (slen < plen) {
-            return false;
-        }
+    /* Compare the start of the string to see if it matches the prefix. */
+    return (memcmp(str.data(), prefix.data(), prefix.size()) == 0);
+}
+
+bool strings::endsWith(stringview_t str, stringview_t suffix) noexcept {
+    /* All strings - even empty ones - end with an empty suffix. */
+    if (suffix.empty()) {
+        return true;
+    }
+
+    /* Strings shorter than the suffix cannot end with the suffix. */
+    if (str.size() < suffix.size()) {
+        return false;
+    }
+
+    /* Compare the end of the string to see if it matches the suffix. */
+    return (memcmp(str.data() + str.size() - suffix.size(), suffix.data(), suffix.size()) == 0);
+}
+
+
+// MARK: Case conversion and comparison
 
-        /* Compare the start of the string to see if it matches the prefix. */
-        return (strncmp(str, prefix, plen) == 0);
+// The char versions work a block at a time. For blocks that are all ASCII the case
+// is changed by adding or removing 0x20 from the letters, and for comparisons both
+// blocks are folded to lowercase and compared. Blocks containing a non-ASCII byte,
+// and any bytes following the last full block, use the locale based functions.
+
+namespace {
+
+#if defined(__AVX2__)
+    constexpr size_t blockSize = 32;
+
+    // Change the case of the characters in [first, first+n) that are in [lo, hi],
+    // writing them to dest. This stops at the first block that contains a non-ASCII
+    // byte, or is not complete, and returns the number of bytes written.
+    size_t changeCaseBlocks(const char* first, size_t n, char* dest, char lo, char hi) noexcept {
+        const __m256i below = _mm256_set1_epi8(char(lo - 1));
+        const __m256i above = _mm256_set1_epi8(char(hi + 1));
+        const __m256i flip = _mm256_set1_epi8(0x20);
+        size_t i = 0;
+        for (; n - i >= blockSize; i += blockSize) {
+            const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i));
+            if (_mm256_movemask_epi8(block) != 0) {
+                break;
+            }
+            const __m256i inRange = _mm256_and_si256(_mm256_cmpgt_epi8(block, below),
+                                                     _mm256_cmpgt_epi8(above, block));
+            const __m256i result = _mm256_xor_si256(block, _mm256_and_si256(inRange, flip));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), result);
+        }
+        return i;
     }
 
-    bool kss_ends_with(const char* str, const char* suffix) {
-        assert(str != nullptr);
-        assert(suffix != nullptr);
+    inline __m256i foldBlock(__m256i block) noexcept {
+        const __m256i inRange = _mm256_and_si256(_mm256_cmpgt_epi8(block, _mm256_set1_epi8('A' - 1)),
+                                                 _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), block));
+        return _mm256_or_si256(block, _mm256_and_si256(inRange, _mm256_set1_epi8(0x20)));
+    }
 
-        /* All strings - event empty ones - end with an empty suffix. */
-        size_t suflen = strlen(suffix);
-        if (!suflen) {
-            return true;
+    // Returns the number of bytes, in whole blocks, that a and b have in common
+    // ignoring case. This stops at the first block that contains a non-ASCII byte or
+    // a difference, or is not complete.
+    size_t equalFoldedBlocks(const char* a, const char* b, size_t n) noexcept {
+        size_t i = 0;
+        for (; n - i >= blockSize; i += blockSize) {
+            const __m256i ablock = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            const __m256i bblock = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            if (_mm256_movemask_epi8(_mm256_or_si256(ablock, bblock)) != 0) {
+                break;
+            }
+            const __m256i eq = _mm256_cmpeq_epi8(foldBlock(ablock), foldBlock(bblock));
+            if (unsigned(_mm256_movemask_epi8(eq)) != 0xFFFFFFFFU) {
+                break;
+            }
         }
+        return i;
+    }
+#elif defined(__SSE2__)
+    constexpr size_t blockSize = 16;
+
+    size_t changeCaseBlocks(const char* first, size_t n, char* dest, char lo, char hi) noexcept {
+        const __m128i below = _mm_set1_epi8(char(lo - 1));
+        const __m128i above = _mm_set1_epi8(char(hi + 1));
+        const __m128i flip = _mm_set1_epi8(0x20);
+        size_t i = 0;
+        for (; n - i >= blockSize; i += blockSize) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+            if (_mm_movemask_epi8(block) != 0) {
+                break;
+            }
+            const __m128i inRange = _mm_and_si128(_mm_cmpgt_epi8(block, below),
+                                                  _mm_cmplt_epi8(block, above));
+            const __m128i result = _mm_xor_si128(block, _mm_and_si128(inRange, flip));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), result);
+        }
+        return i;
+    }
 
-        /* Empty strings, or strings shorter than the suffix, cannot end with the suffix. */
-        size_t slen = strlen(str);
-        if (slen < suflen) {
-            return false;
+    inline __m128i foldBlock(__m128i block) noexcept {
+        const __m128i inRange = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('A' - 1)),
+                                              _mm_cmplt_epi8(block, _mm_set1_epi8('Z' + 1)));
+        return _mm_or_si128(block, _mm_and_si128(inRange, _mm_set1_epi8(0x20)));
+    }
+
+    size_t equalFoldedBlocks(const char* a, const char* b, size_t n) noexcept {
+        size_t i = 0;
+        for (; n - i >= blockSize; i += blockSize) {
+            const __m128i ablock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            const __m128i bblock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            if (_mm_movemask_epi8(_mm_or_si128(ablock, bblock)) != 0) {
+                break;
+            }
+            const __m128i eq = _mm_cmpeq_epi8(foldBlock(ablock), foldBlock(bblock));
+            if (_mm_movemask_epi8(eq) != 0xFFFF) {
+                break;
+            }
         }
+        return i;
+    }
+#else
+    constexpr size_t blockSize = 16;
 
-        /* Compare the end of the string to see if it matches the suffix. */
-        return (strncmp(str+slen-suflen, suffix, suflen) == 0);
+    inline size_t changeCaseBlocks(const char*, size_t, char*, char, char) noexcept {
+        return 0;
+    }
+
+    inline size_t equalFoldedBlocks(const char*, const char*, size_t) noexcept {
+        return 0;
+    }
+#endif
+
+    template <class Fn>
+    char* changeCase(stringview_t s, char* dest, char lo, char hi, Fn fn) noexcept {
+        const char* src = s.data();
+        const size_t n = s.size();
+        size_t i = 0;
+        while (i < n) {
+            i += changeCaseBlocks(src + i, n - i, dest + i, lo, hi);
+            const size_t blockEnd = i + min(n - i, blockSize);
+            for (; i < blockEnd; ++i) {
+                dest[i] = char(fn(static_cast<unsigned char>(src[i])));
+            }
+        }
+        return dest + n;
     }
 }
 
-bool strings::startsWith(const string &str, const string &prefix) noexcept {
-    return kss_starts_with(str.c_str(), prefix.c_str());
+char* strings::toUpper(stringview_t s, char* dest) noexcept {
+    return changeCase(s, dest, 'a', 'z', ::toupper);
 }
 
-bool strings::endsWith(const string &str, const string &suffix) noexcept {
-    return kss_ends_with(str.c_str(), suffix.c_str());
+char* strings::toLower(stringview_t s, char* dest) noexcept {
+    return changeCase(s, dest, 'A', 'Z', ::tolower);
 }
 
 string& strings::toUpper(string& s) noexcept {
-	transform(s.begin(), s.end(), s.begin(), ::toupper);
+	toUpper(s, &s[0]);
 	return s;
 }
 
@@ -165,7 +351,7 @@ wstring& strings::toUpper(wstring& s) noexcept {
 }
 
 string& strings::toLower(string& s) noexcept {
-	transform(s.begin(), s.end(), s.begin(), ::tolower);
+	toLower(s, &s[0]);
 	return s;
 }
 
@@ -174,8 +360,8 @@ wstring& strings::toLower(wstring& s) noexcept {
 	return s;
 }
 
-bool strings::iequal(const string& a, const string& b) noexcept {
-    return (icompare(a, b) == 0);
+bool strings::iequal(stringview_t a, stringview_t b) noexcept {
+    return (a.size() == b.size() && icompare(a, b) == 0);
 }
 
 bool strings::iequal(const wstring& a, const wstring& b) noexcept {
@@ -208,8 +394,25 @@ namespace {
     }
 }
 
-int strings::icompare(const string& a, const string& b) noexcept {
-    return _icompare<string>(a, b, [](int ch){ return std::tolower(ch); });
+// This follows _icompare, but skips the blocks that are equal ignoring case.
+int strings::icompare(stringview_t a, stringview_t b) noexcept {
+    const size_t len = std::min(a.size(), b.size());
+    size_t i = 0;
+    while (i < len) {
+        i += equalFoldedBlocks(a.data() + i, b.data() + i, len - i);
+        const size_t blockEnd = i + min(len - i, blockSize);
+        for (; i < blockEnd; ++i) {
+            const int diff = std::tolower(static_cast<unsigned char>(a[i]))
+                - std::tolower(static_cast<unsigned char>(b[i]));
+            if (diff) { return diff; }
+        }
+    }
+
+    if (a.size() < b.size())        { return -1; }
+    else if (a.size() > b.size())   { return 1; }
+    else {
+        return 0;
+    }
 }
 
 int strings::icompare(const wstring& a, const wstring& b) noexcept {
@@ -15,40 +15,107 @@
 #ifndef kssutil_stringutil_hpp
 #define kssutil_stringutil_hpp
 
+#include <cstdarg>
 #include <string>
 
+#include "stringview.hpp"
+
+/*!
+ Marks a function as taking a printf style pattern in parameter fmtIdx followed by
+ its arguments starting at parameter firstArg (or 0 for a va_list), so that the
+ compiler can check the arguments against the pattern.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#   define KSS_PRINTF_FORMAT(fmtIdx, firstArg) __attribute__((format(printf, fmtIdx, firstArg)))
+#else
+#   define KSS_PRINTF_FORMAT(fmtIdx, firstArg)
+#endif
+
 namespace kss { namespace util { namespace strings {
 
     /*!
-     Perform printf style formatting and return the resulting string.
+     Perform printf style formatting and return the resulting string. When the
+     pattern is a C string the compiler checks the arguments against it, where
+     supported.
      @throws std::invalid_argument if the pattern is empty
      @throws std::system_error if there is a problem with an underlying C call
      */
+    std::string format(const char* pattern, ...) KSS_PRINTF_FORMAT(1, 2);
     std::string format(std::string pattern, ...);
     std::string vformat(const std::string& pattern, va_list ap);
 
+    /*!
+     Perform printf style formatting, appending the result to s. Short results are
+     formatted on the stack and appended, while longer ones are written directly
+     into s, so no intermediate buffer is allocated, and reusing the same string for
+     each call avoids any allocation. The cost of each call depends only on the
+     length of the result, not the size or capacity of s. If an exception is thrown
+     s is left unchanged.
+     @return a reference to s
+     @throws std::invalid_argument if the pattern is NULL or empty
+     @throws std::system_error if there is a problem with an underlying C call
+     */
+    std::string& appendFormat(std::string& s, const char* pattern, ...) KSS_PRINTF_FORMAT(2, 3);
+    std::string& vappendFormat(std::string& s, const char* pattern, va_list ap) KSS_PRINTF_FORMAT(2, 0);
+
     /*!
      Trim whitespace or a specific repeating character from a string. The modified
      string is also returned. Note that there are versions to trim only the left (l),
-     the right (r) or both.
+     the right (r) or both. Trimming both sides moves the remaining characters at
+     most once.
      @return the modified string.
      */
     std::string& ltrim(std::string& s) noexcept;
     std::string& ltrim(std::string& s, char c) noexcept;
     std::string& rtrim(std::string& s) noexcept;
     std::string& rtrim(std::string& s, char c) noexcept;
-    inline std::string& trim(std::string& s) noexcept { return ltrim(rtrim(s)); }
-    inline std::string& trim(std::string& s, char c) noexcept { return ltrim(rtrim(s, c), c); }
+    std::string& trim(std::string& s) noexcept;
+    std::string& trim(std::string& s, char c) noexcept;
+
+    /*!
+     Non-modifying versions of the trim functions. These return a view of the part
+     of s that remains after trimming, so nothing is copied or moved. They are used
+     for anything other than a modifiable std::string, e.g. a const std::string, a
+     substring_t or a C string, but not a temporary std::string, as the view would
+     refer to a destroyed string.
+     @return the trimmed view
+     */
+    stringview_t ltrim(stringview_t s) noexcept;
+    stringview_t ltrim(stringview_t s, char c) noexcept;
+    stringview_t rtrim(stringview_t s) noexcept;
+    stringview_t rtrim(stringview_t s, char c) noexcept;
+    inline stringview_t trim(stringview_t s) noexcept { return ltrim(rtrim(s)); }
+    inline stringview_t trim(stringview_t s, char c) noexcept { return ltrim(rtrim(s, c), c); }
+
+    template <class Alloc>
+    stringview_t ltrim(std::basic_string<char, std::char_traits<char>, Alloc>&& s) = delete;
+    template <class Alloc>
+    stringview_t ltrim(std::basic_string<char, std::char_traits<char>, Alloc>&& s, char c) = delete;
+    template <class Alloc>
+    stringview_t rtrim(std::basic_string<char, std::char_traits<char>, Alloc>&& s) = delete;
+    template <class Alloc>
+    stringview_t rtrim(std::basic_string<char, std::char_traits<char>, Alloc>&& s, char c) = delete;
+    template <class Alloc>
+    stringview_t trim(std::basic_string<char, std::char_traits<char>, Alloc>&& s) = delete;
+    template <class Alloc>
+    stringview_t trim(std::basic_string<char, std::char_traits<char>, Alloc>&& s, char c) = delete;
 
     /*!
-     Determine if a string starts or ends with another string.
+     Determine if a string starts or ends with another string. The comparison uses
+     the lengths of the strings, so they may contain NUL characters. To test a string
+     against many prefixes at once, use a PrefixMatcher.
      */
-    bool startsWith(const std::string& str, const std::string& prefix) noexcept;
-    bool endsWith(const std::string& str, const std::string& suffix) noexcept;
+    bool startsWith(stringview_t str, stringview_t prefix) noexcept;
+    bool endsWith(stringview_t str, stringview_t suffix) noexcept;
 
     /*!
      Convert strings to upper or lowercase. This can be done either in place or
      by creating new strings.
+
+     The char versions convert 16 or 32 bytes at a time, when the library is
+     compiled with SSE2 or AVX2 support, using the ASCII rules. Only blocks that
+     contain non-ASCII bytes are converted using the current locale.
+
      @return either a reference to the, now modified, string or a new string.
      @throws std::bad_alloc if a new string could not be allocated.
      */
@@ -76,18 +143,50 @@ namespace kss { namespace util { namespace strings {
         return toLower(s2);
     }
 
+    /*!
+     Write the upper or lowercase form of s to dest, which must have room for
+     s.size() characters. It may be s.data() itself, but must not otherwise overlap
+     s. This allows conversion into an existing buffer without creating a string.
+     @return dest + s.size()
+     */
+    char* toUpper(stringview_t s, char* dest) noexcept;
+    char* toLower(stringview_t s, char* dest) noexcept;
+
 
     /*!
-     Case insensitive string comparison.
+     Case insensitive string comparison. The char versions take views, so that
+     neither string is copied, and like toUpper and toLower compare a block at a
+     time, only using the current locale for blocks containing non-ASCII bytes.
      @return true (iequal) if the two string are equal except for case
      @return <0,0,or >0 (icompare) based on the string comparison. (i.e. like strcmp)
      */
-    bool iequal(const std::string& a, const std::string& b) noexcept;
+    bool iequal(stringview_t a, stringview_t b) noexcept;
     bool iequal(const std::wstring& a, const std::wstring& b) noexcept;
-    int icompare(const std::string& a, const std::string& b) noexcept;
+    int icompare(stringview_t a, stringview_t b) noexcept;
     int icompare(const std::wstring& a, const std::wstring& b) noexcept;
 
 
+    namespace _private {
+        template <class Char, class Traits, class Alloc>
+        unsigned countOccurrencesOf(const std::basic_string<Char, Traits, Alloc>& source,
+                                    const Char* substr,
+                                    typename std::basic_string<Char, Traits, Alloc>::size_type n,
+                                    bool allowOverlaps) noexcept
+        {
+            using string_t = std::basic_string<Char, Traits, Alloc>;
+            const typename string_t::size_type step = (allowOverlaps ? 1 : n);
+            unsigned count = 0;
+            typename string_t::size_type pos = 0;
+
+            while ((pos = source.find(substr, pos, n)) != string_t::npos) {
+                pos += step;
+                ++count;
+            }
+
+            return count;
+        }
+    }
+
     /*!
      Count the number of times a substring occurs in a source string. This should
      work on any object that follows the basic_string API.
@@ -95,6 +194,9 @@ namespace kss { namespace util { namespace strings {
      This is based on code found at:
      https://stackoverflow.com/questions/6067460/c-how-to-calculate-the-number-time-a-string-occurs-in-a-data
 
+     To count many different substrings, use a PatternMatcher, which searches for
+     all of them in a single pass.
+
      @param source The string being searched.
      @param substr The sub-string we are looking for.
      @param allowOverlaps If true then overlapping substrings are counted separately.
@@ -105,17 +207,7 @@ namespace kss { namespace util { namespace strings {
                                 const std::basic_string<Char, traits, Alloc>& substr,
                                 bool allowOverlaps = false) noexcept
     {
-        using string_t = std::basic_string<Char, traits, Alloc>;
-        const typename string_t::size_type step = (allowOverlaps ? 1 : substr.size());
-        unsigned count = 0;
-        typename string_t::size_type pos = 0;
-
-        while ((pos = source.find(substr, pos)) != string_t::npos) {
-            pos += step;
-            ++count;
-        }
-
-        return count;
+        return _private::countOccurrencesOf(source, substr.data(), substr.size(), allowOverlaps);
     }
 
     template <class Char, class Traits = std::char_traits<Char>, class Alloc = std::allocator<Char>>
@@ -123,8 +215,7 @@ namespace kss { namespace util { namespace strings {
                                        const Char* substr,
                                        bool allowOverlaps = false) noexcept
     {
-        using string_t = std::basic_string<Char, Traits, Alloc>;
-        return countOccurrencesOf(source, string_t(substr), allowOverlaps);
+        return _private::countOccurrencesOf(source, substr, Traits::length(substr), allowOverlaps);
     }
 }}}
 
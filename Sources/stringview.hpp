@@ -0,0 +1,305 @@
+//
+//  stringview.hpp
+//  kssutil
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+
+/*!
+ \file
+ \brief Non-owning, read-only view of a sequence of characters.
+ */
+
+#ifndef kssutil_stringview_hpp
+#define kssutil_stringview_hpp
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+#include "substring.hpp"
+
+namespace kss { namespace util { namespace strings {
+
+    /*!
+     \brief Read-only view of a sequence of characters.
+
+     A StringView refers to characters owned by something else (a std::string, a
+     SubString, a NULL-terminated C string or any other buffer) without copying
+     them. It is a subset of the C++17 std::string_view, provided since this library
+     is built using C++14. As with std::string_view, the view becomes invalid when
+     the underlying characters are modified or go out of scope, and the characters
+     are not necessarily NULL-terminated.
+
+     Since the constructors are implicit, a StringView parameter will accept a
+     std::basic_string, a SubString or a const Char* without any memory allocation.
+     */
+    template <class Char, class Traits = std::char_traits<Char>>
+    class StringView {
+    public:
+        using traits_type = Traits;
+        using value_type = Char;
+        using pointer = Char*;
+        using const_pointer = const Char*;
+        using reference = Char&;
+        using const_reference = const Char&;
+        using const_iterator = const Char*;
+        using iterator = const_iterator;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        using reverse_iterator = const_reverse_iterator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        static constexpr size_type npos = size_type(-1);
+
+        /*!
+         Construct a view. A NULL s is treated as an empty string.
+         */
+        constexpr StringView() noexcept = default;
+
+        constexpr StringView(const Char* s, size_type count) noexcept
+        : _data(s), _size(count)
+        {}
+
+        StringView(const Char* s) noexcept
+        : _data(s), _size(s ? Traits::length(s) : 0)
+        {}
+
+        template <class Alloc>
+        StringView(const std::basic_string<Char, Traits, Alloc>& s) noexcept
+        : _data(s.data()), _size(s.size())
+        {}
+
+        template <class Alloc>
+        StringView(const SubString<Char, Traits, Alloc>& s) noexcept
+        : _data(s.data()), _size(s.size())
+        {}
+
+        constexpr StringView(const StringView&) noexcept = default;
+        StringView& operator=(const StringView&) noexcept = default;
+
+        /*!
+         Convert to a string. Unlike the view, the string owns a copy of the characters.
+         @throws std::bad_alloc if the string could not be allocated.
+         */
+        std::basic_string<Char, Traits> to_string() const {
+            return std::basic_string<Char, Traits>(_data, _size);
+        }
+
+        template <class Alloc>
+        explicit operator std::basic_string<Char, Traits, Alloc>() const {
+            return std::basic_string<Char, Traits, Alloc>(_data, _size);
+        }
+
+        /*!
+         Iterators. These are simply pointers into the underlying characters.
+         */
+        constexpr const_iterator begin() const noexcept         { return _data; }
+        constexpr const_iterator end() const noexcept           { return _data + _size; }
+        constexpr const_iterator cbegin() const noexcept        { return _data; }
+        constexpr const_iterator cend() const noexcept          { return _data + _size; }
+        const_reverse_iterator rbegin() const noexcept          { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend() const noexcept            { return const_reverse_iterator(begin()); }
+
+        /*!
+         Element access. operator[], front() and back() are unchecked.
+         @throws std::out_of_range if at() is given a position that is not in the view.
+         */
+        constexpr const_reference operator[](size_type pos) const noexcept { return _data[pos]; }
+        constexpr const_reference front() const noexcept        { return _data[0]; }
+        constexpr const_reference back() const noexcept         { return _data[_size-1]; }
+        constexpr const_pointer data() const noexcept           { return _data; }
+
+        const_reference at(size_type pos) const {
+            if (pos >= _size) {
+                throw std::out_of_range("pos is out of range of this StringView");
+            }
+            return _data[pos];
+        }
+
+        /*!
+         Capacity.
+         */
+        constexpr size_type size() const noexcept               { return _size; }
+        constexpr size_type length() const noexcept             { return _size; }
+        constexpr bool empty() const noexcept                   { return (_size == 0); }
+
+        /*!
+         Modifiers. These only change the view, not the underlying characters. Note
+         that n must not be larger than size().
+         */
+        void remove_prefix(size_type n) noexcept    { _data += n; _size -= n; }
+        void remove_suffix(size_type n) noexcept    { _size -= n; }
+        void swap(StringView& v) noexcept           { std::swap(_data, v._data); std::swap(_size, v._size); }
+
+        /*!
+         Return a view of the at most n characters starting at pos.
+         @throws std::out_of_range if pos > size()
+         */
+        StringView substr(size_type pos = 0, size_type n = npos) const {
+            if (pos > _size) {
+                throw std::out_of_range("pos is out of range of this StringView");
+            }
+            return StringView(_data + pos, std::min(n, _size - pos));
+        }
+
+        /*!
+         Lexicographically compare with another view, returning a negative value, zero,
+         or a positive value in the same manner as std::string::compare.
+         */
+        int compare(StringView v) const noexcept {
+            const int ret = (_size == 0 || v._size == 0 ? 0 : Traits::compare(_data, v._data, std::min(_size, v._size)));
+            if (ret != 0) {
+                return ret;
+            }
+            return (_size < v._size ? -1 : (_size > v._size ? 1 : 0));
+        }
+
+        /*!
+         Searching. These follow the std::string methods of the same names, returning
+         npos if nothing is found.
+         */
+        size_type find(Char ch, size_type pos = 0) const noexcept {
+            if (pos >= _size) {
+                return npos;
+            }
+            const Char* p = Traits::find(_data + pos, _size - pos, ch);
+            return (p ? size_type(p - _data) : npos);
+        }
+
+        size_type find(StringView v, size_type pos = 0) const noexcept {
+            if (v._size > _size || pos > _size - v._size) {
+                return npos;
+            }
+            if (v._size == 0) {
+                return pos;
+            }
+            for (const Char* p = _data + pos, *last = _data + (_size - v._size); p <= last; ++p) {
+                p = Traits::find(p, size_type(last - p) + 1, v._data[0]);
+                if (!p) {
+                    break;
+                }
+                if (Traits::compare(p, v._data, v._size) == 0) {
+                    return size_type(p - _data);
+                }
+            }
+            return npos;
+        }
+
+        size_type rfind(Char ch, size_type pos = npos) const noexcept {
+            if (_size == 0) {
+                return npos;
+            }
+            for (size_type i = std::min(pos, _size - 1) + 1; i > 0; --i) {
+                if (Traits::eq(_data[i-1], ch)) {
+                    return i-1;
+                }
+            }
+            return npos;
+        }
+
+        size_type find_first_of(StringView v, size_type pos = 0) const noexcept {
+            for (size_type i = pos; i < _size; ++i) {
+                if (Traits::find(v._data, v._size, _data[i])) {
+                    return i;
+                }
+            }
+            return npos;
+        }
+
+        size_type find_first_not_of(StringView v, size_type pos = 0) const noexcept {
+            for (size_type i = pos; i < _size; ++i) {
+                if (!Traits::find(v._data, v._size, _data[i])) {
+                    return i;
+                }
+            }
+            return npos;
+        }
+
+        size_type find_last_not_of(StringView v, size_type pos = npos) const noexcept {
+            if (_size == 0) {
+                return npos;
+            }
+            for (size_type i = std::min(pos, _size - 1) + 1; i > 0; --i) {
+                if (!Traits::find(v._data, v._size, _data[i-1])) {
+                    return i-1;
+                }
+            }
+            return npos;
+        }
+
+        /*!
+         Comparisons. These are written as non-template friends, rather than using
+         AddRelOps, so that a std::basic_string, SubString or const Char* on either side
+         will be implicitly converted to a StringView.
+         */
+        friend bool operator==(StringView a, StringView b) noexcept {
+            return (a._size == b._size && a.compare(b) == 0);
+        }
+        friend bool operator!=(StringView a, StringView b) noexcept { return !(a == b); }
+        friend bool operator<(StringView a, StringView b) noexcept  { return (a.compare(b) < 0); }
+        friend bool operator<=(StringView a, StringView b) noexcept { return (a.compare(b) <= 0); }
+        friend bool operator>(StringView a, StringView b) noexcept  { return (a.compare(b) > 0); }
+        friend bool operator>=(StringView a, StringView b) noexcept { return (a.compare(b) >= 0); }
+
+        /*!
+         Write the characters to a stream.
+         */
+        friend std::basic_ostream<Char, Traits>& operator<<(std::basic_ostream<Char, Traits>& strm, StringView v) {
+            return strm.write(v._data, std::streamsize(v._size));
+        }
+
+    private:
+        const Char* _data = nullptr;
+        size_type   _size = 0;
+    };
+
+    template <class Char, class Traits>
+    constexpr typename StringView<Char, Traits>::size_type StringView<Char, Traits>::npos;
+
+
+    /*!
+     Shorthand for a view of char characters.
+     */
+    using stringview_t = StringView<char>;
+
+    /*!
+     Shorthand for a view of wchar_t characters.
+     */
+    using wstringview_t = StringView<wchar_t>;
+
+
+    /*!
+     \brief Transparent hash function for strings.
+
+     Computes the same hash (FNV-1a) for anything that can be converted to a
+     StringView<Char>, so that it can be used along with std::equal_to<> to look up
+     std::basic_string keys using a StringView, SubString or const Char* without
+     creating a temporary string.
+     */
+    template <class Char, class Traits = std::char_traits<Char>>
+    struct BasicStringHash {
+        using is_transparent = void;
+
+        std::size_t operator()(StringView<Char, Traits> v) const noexcept {
+            std::size_t h = (sizeof(std::size_t) > 4 ? std::size_t(14695981039346656037ULL) : std::size_t(2166136261U));
+            const std::size_t prime = (sizeof(std::size_t) > 4 ? std::size_t(1099511628211ULL) : std::size_t(16777619U));
+            const unsigned char* p = reinterpret_cast<const unsigned char*>(v.data());
+            for (std::size_t i = 0, n = v.size() * sizeof(Char); i < n; ++i) {
+                h = (h ^ p[i]) * prime;
+            }
+            return h;
+        }
+    };
+
+    using StringHash = BasicStringHash<char>;
+    using WStringHash = BasicStringHash<wchar_t>;
+
+}}}
+
+#endif
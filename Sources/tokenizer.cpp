@@ -7,6 +7,10 @@
 //  Licensing follows the MIT License.
 //
 
+#include <algorithm>
+#include <future>
+#include <thread>
+
 #include <kss/contract/all.h>
 
 #include "tokenizer.hpp"
@@ -43,7 +47,7 @@ Tokenizer::Tokenizer(const string& s,
 Tokenizer::Tokenizer(string&& s,
                      const string& delim,
                      string::size_type start, string::size_type end)
-: _s(s), _delim(delim)
+: _s(std::move(s)), _delim(delim)
 {
     contract::parameters({
         KSS_EXPR(!delim.empty())
@@ -63,35 +67,206 @@ Tokenizer::Tokenizer(string&& s,
 }
 
 
-// Obtain the next token.
+// Obtain the next token. We assign into token, rather than assigning substr()
+// results, so that its existing capacity is reused.
 string& Tokenizer::next(string& token) {
     contract::preconditions({
         KSS_EXPR(hasAnother() == true)
     });
 
-    string::size_type pos = _s.find_first_of(_delim, _lastPos);
+    // Only search up to _end, anything beyond that is treated as not found.
+    const string::size_type pos = _delim.find(stringview_t(_s.data(), _end), _lastPos);
 
     if (pos >= _end) {
         // final token
         if (_lastPos < _end) {
-            token = _s.substr(_lastPos, (_end - _lastPos));
+            token.assign(_s, _lastPos, (_end - _lastPos));
         }
         else {
             // Final token is the empty token.
-            token = string();
+            token.clear();
         }
         _lastPos = _end+1;
     }
     else if (pos == _lastPos) {
         // empty token
         ++_lastPos;
-        token = string();
+        token.clear();
     }
     else {
         // next token
-        token = _s.substr(_lastPos, (pos - _lastPos));
+        token.assign(_s, _lastPos, (pos - _lastPos));
+        _lastPos = pos + 1;
+    }
+
+    return token;
+}
+
+
+ViewTokenizer::ViewTokenizer(stringview_t s,
+                             const string& delim,
+                             stringview_t::size_type start,
+                             stringview_t::size_type end)
+: _s(s), _delim(delim)
+{
+    contract::parameters({
+        KSS_EXPR(!delim.empty())
+    });
+
+    _lastPos = start;
+    _end = min(end, _s.length());
+    if (_lastPos == _end) {
+        _lastPos = _end+1;
+    }
+
+    contract::postconditions({
+        KSS_EXPR(!_delim.empty()),
+        KSS_EXPR((_lastPos == start) || (_lastPos == (_end+1))),
+        KSS_EXPR(_end <= end)
+    });
+}
+
+// This follows Tokenizer::next, but the tokens are views into _s.
+stringview_t& ViewTokenizer::next(stringview_t& token) {
+    contract::preconditions({
+        KSS_EXPR(hasAnother() == true)
+    });
+
+    const stringview_t::size_type pos = _delim.find(_s.substr(0, _end), _lastPos);
+
+    if (pos >= _end) {
+        // final token, which may be empty
+        token = stringview_t(_s.data() + min(_lastPos, _end), (_lastPos < _end ? _end - _lastPos : 0));
+        _lastPos = _end+1;
+    }
+    else {
+        // next token, which is empty if pos == _lastPos
+        token = stringview_t(_s.data() + _lastPos, pos - _lastPos);
         _lastPos = pos + 1;
     }
 
     return token;
 }
+
+
+namespace {
+
+    // Chunks smaller than this are not worth a thread of their own when the number
+    // of chunks is chosen automatically.
+    constexpr size_t minAutoChunkSize = 64 * 1024;
+
+    // Returns the chunk boundaries. Every boundary other than the first and last is
+    // just after a delimiter, so no token spans two chunks. There may be fewer than
+    // numChunks chunks if there are not enough delimiters.
+    vector<size_t> chunkBoundaries(stringview_t s, const DelimiterSet& delim, size_t numChunks) {
+        vector<size_t> bounds { 0 };
+        const size_t chunkSize = s.size() / numChunks;
+        for (size_t i = 1; i < numChunks; ++i) {
+            const size_t pos = delim.find(s, max(chunkSize * i, bounds.back()));
+            if (pos == stringview_t::npos) {
+                break;
+            }
+            bounds.push_back(pos + 1);
+        }
+        bounds.push_back(s.size());
+        return bounds;
+    }
+
+    // Tokenize the chunk [first, last) of s. All but the last chunk end with a
+    // delimiter, so only the last has a final token that is not followed by one.
+    vector<stringview_t> tokenizeChunk(stringview_t s, size_t first, size_t last,
+                                       const DelimiterSet& delim, bool isLastChunk)
+    {
+        vector<stringview_t> tokens;
+        const char* p = s.data() + first;
+        const char* end = s.data() + last;
+        while (true) {
+            const char* q = delim.find(p, end);
+            if (q == end) {
+                break;
+            }
+            tokens.emplace_back(p, size_t(q - p));
+            p = q + 1;
+        }
+        if (isLastChunk) {
+            tokens.emplace_back(p, size_t(end - p));
+        }
+        return tokens;
+    }
+
+    // Start tokenizing s in chunks. All but the first chunk are tokenized
+    // asynchronously, their futures being added to rest in chunk order, while the
+    // first is tokenized on the calling thread and its tokens returned. Note that
+    // the futures refer to delim, so it must outlive them.
+    using chunk_future = future<vector<stringview_t>>;
+
+    vector<stringview_t> tokenizeChunks(stringview_t s, const DelimiterSet& delim,
+                                        size_t numChunks, vector<chunk_future>& rest)
+    {
+        if (numChunks == 0) {
+            numChunks = min<size_t>(thread::hardware_concurrency(), s.size() / minAutoChunkSize);
+        }
+        numChunks = max<size_t>(min(numChunks, s.size()), 1);
+
+        const auto bounds = chunkBoundaries(s, delim, numChunks);
+        const size_t n = bounds.size() - 1;
+        rest.reserve(n - 1);
+        for (size_t i = 1; i < n; ++i) {
+            rest.push_back(async(launch::async, tokenizeChunk, s, bounds[i], bounds[i+1],
+                                 cref(delim), (i == n-1)));
+        }
+        return tokenizeChunk(s, bounds[0], bounds[1], delim, (n == 1));
+    }
+}
+
+// We wait for all the chunks so that the result is sized once, rather than being
+// grown as each chunk is added.
+vector<stringview_t> kss::util::strings::parallelTokenize(stringview_t s,
+                                                          const string& delims,
+                                                          size_t numChunks)
+{
+    contract::parameters({
+        KSS_EXPR(!delims.empty())
+    });
+
+    vector<stringview_t> tokens;
+    if (!s.empty()) {
+        const DelimiterSet delim(delims);
+        vector<chunk_future> rest;
+        tokens = tokenizeChunks(s, delim, numChunks, rest);
+
+        vector<vector<stringview_t>> chunks;
+        chunks.reserve(rest.size());
+        size_t total = tokens.size();
+        for (auto& f : rest) {
+            chunks.push_back(f.get());
+            total += chunks.back().size();
+        }
+        tokens.reserve(total);
+        for (const auto& chunk : chunks) {
+            tokens.insert(tokens.end(), chunk.begin(), chunk.end());
+        }
+    }
+    return tokens;
+}
+
+// Should fn throw, the destructors of the remaining futures wait for their threads,
+// so s and delim remain valid for as long as the threads use them.
+void kss::util::strings::parallelTokenize(stringview_t s,
+                                          const string& delims,
+                                          size_t numChunks,
+                                          const function<void(const vector<stringview_t>&)>& fn)
+{
+    contract::parameters({
+        KSS_EXPR(!delims.empty())
+    });
+
+    if (!s.empty()) {
+        const DelimiterSet delim(delims);
+        vector<chunk_future> rest;
+        fn(tokenizeChunks(s, delim, numChunks, rest));
+        for (auto& f : rest) {
+            fn(f.get());
+        }
+    }
+}
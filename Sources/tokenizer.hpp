@@ -15,8 +15,14 @@
 #ifndef kssutil_tokenizer_hpp
 #define kssutil_tokenizer_hpp
 
+#include <cstddef>
+#include <functional>
 #include <string>
+#include <vector>
+
+#include "delimiterset.hpp"
 #include "iterator.hpp"
+#include "stringview.hpp"
 
 namespace kss { namespace util { namespace strings {
 
@@ -27,6 +33,10 @@ namespace kss { namespace util { namespace strings {
      on code published at http://stackoverflow.com/questions/236129/split-a-string-in-c.
 
      This provides either a stream based or an input iterator based view of the tokens.
+
+     The Tokenizer makes its own copy of the string, and each token is copied into a
+     std::string. When the input will outlive the tokenizer, consider using a
+     ViewTokenizer instead, which avoids both copies.
      */
     class Tokenizer {
     public:
@@ -85,11 +95,118 @@ namespace kss { namespace util { namespace strings {
 
     private:
         std::string             _s;
-        std::string             _delim;
+        DelimiterSet            _delim;
         std::string::size_type  _lastPos;
         std::string::size_type  _end;
     };
 
+
+    /*!
+     \brief Zero-copy version of the Tokenizer.
+
+     This provides the same tokens as a Tokenizer, but instead of copying the string
+     and each token, it borrows the string and returns each token as a stringview_t
+     referring to the characters of that string. Hence no memory is allocated per
+     token, but the string must not be modified or destroyed while the tokenizer, or
+     any of the tokens, are in use.
+     */
+    class ViewTokenizer {
+    public:
+        /*!
+         Container/iterator based type definitions.
+         */
+        using value_type = stringview_t;
+        using iterator = kss::util::iterators::ForwardIterator<ViewTokenizer, stringview_t>;
+
+        /*!
+         Create the tokenizer for a given string and delimiter set. The string may be
+         given as anything that can be converted to a stringview_t, for example a
+         std::string, a substring_t, or a const char*, but not a temporary std::string.
+         Note that having two or more delimiters in a row will lead to empty tokens.
+
+         @param s is the string to be split into tokens
+         @param delims is the set of delimiters
+         @param start is the position in s to start searching
+         @param end is the position in s one after the position to end searching
+         @throws std::invalid_argument if delim is an empty string
+         @throws any exceptions that may be thrown by the std::string class
+         */
+        explicit ViewTokenizer(stringview_t s,
+                               const std::string& delims = " \t\n\r",
+                               stringview_t::size_type start = 0,
+                               stringview_t::size_type end = stringview_t::npos);
+        template <class Alloc>
+        explicit ViewTokenizer(std::basic_string<char, std::char_traits<char>, Alloc>&& s,
+                               const std::string& delims = " \t\n\r",
+                               stringview_t::size_type start = 0,
+                               stringview_t::size_type end = stringview_t::npos) = delete;
+        ~ViewTokenizer() noexcept = default;
+
+        /*!
+         Returns true if there is another item available and false otherwise.
+         */
+        inline bool hasAnother() const noexcept {
+            return (_lastPos <= _end);
+        }
+
+        /*!
+         Retrieves the next token and places it in token. It is invalid to call this
+         if there are no more tokens.
+         @return a reference to token
+         */
+        stringview_t& next(stringview_t& token);
+
+        /*!
+         Iterator based access. As with the Tokenizer, you should use either this or
+         the stream based access, but not both.
+         */
+        iterator begin() { return iterator(*this); }
+        iterator end()   { return iterator(); }
+
+    private:
+        stringview_t            _s;
+        DelimiterSet            _delim;
+        stringview_t::size_type _lastPos;
+        stringview_t::size_type _end;
+    };
+
+
+    /*!
+     Split s into tokens using several threads. The input is cut into chunks, each
+     starting just after a delimiter, the chunks are tokenized concurrently, and the
+     tokens are returned in their original order. The result is exactly that of a
+     ViewTokenizer on s, including any empty tokens.
+
+     The tokens are views into s, hence s must outlive them.
+
+     @param s is the string to be split into tokens
+     @param delims is the set of delimiters
+     @param numChunks is the number of chunks (and threads) to use. If it is 0 this
+        will be chosen based on the number of cores and the size of s.
+     @throws std::invalid_argument if delim is an empty string
+     @throws std::system_error if a thread could not be started
+     @throws std::bad_alloc if the results could not be allocated
+     */
+    std::vector<stringview_t> parallelTokenize(stringview_t s,
+                                               const std::string& delims = " \t\n\r",
+                                               size_t numChunks = 0);
+
+    /*!
+     Callback version of parallelTokenize. Rather than combining the tokens into a
+     single vector, fn is called once per chunk, in chunk order and on the calling
+     thread, with that chunk's tokens. Concatenating the tokens from all the calls
+     gives the same result as the vector version.
+
+     @throws std::invalid_argument if delim is an empty string
+     @throws std::system_error if a thread could not be started
+     @throws std::bad_alloc if the results could not be allocated
+     @throws any exception thrown by fn
+     */
+    void parallelTokenize(stringview_t s,
+                          const std::string& delims,
+                          size_t numChunks,
+                          const std::function<void(const std::vector<stringview_t>&)>& fn);
+
 }}}
 
 #endif
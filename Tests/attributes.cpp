@@ -8,11 +8,13 @@
 //
 
 #include <iostream>
+#include <map>
 #include <stdexcept>
 #include <system_error>
 
 #include <kss/test/all.h>
 #include <kss/util/attributes.hpp>
+#include <kss/util/substring.hpp>
 #include <kss/util/timeutil.hpp>
 
 using namespace std;
@@ -98,5 +100,26 @@ static TestSuite ts("::attributes", {
             mc.setAttribute("duration", "10h");
             return mc.attribute<chrono::seconds>("duration").count();
         }));
+    }),
+    make_pair("lookup by view", [] {
+        MyClass mc;
+        mc.setAttribute("key1", "111");
+        string s("key1=key2");
+        strings::substring_t key1(s, 0, 4);
+        strings::stringview_t key2(s.data() + 5, 4);
+
+        KSS_ASSERT(mc.hasAttribute(key1) && !mc.hasAttribute(key2));
+        KSS_ASSERT(mc.attribute<int>(key1) == 111);
+        KSS_ASSERT(mc.attributeWithDefault(key2, 222) == 222);
+        const map<string, string>& attributeMap = static_cast<const MyClass&>(mc).attributes();
+        KSS_ASSERT(attributeMap.find(string(key1)) != attributeMap.end());
+        KSS_ASSERT(throwsException<invalid_argument>([&] { mc.attribute<int>(key2); }));
+
+        const string skey1("key1");
+        const char* ckey1 = "key1";
+        KSS_ASSERT(mc.hasAttribute(skey1) && mc.hasAttribute(ckey1));
+        KSS_ASSERT(mc.hasAttribute(strings::stringview_t(skey1)));
+        KSS_ASSERT(mc.attribute<int>(skey1) == 111 && mc.attribute<int>(ckey1) == 111);
+        KSS_ASSERT(mc.attributeWithDefault(string("key2"), 222) == 222);
     })
 });
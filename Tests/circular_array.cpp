@@ -8,6 +8,8 @@
 //
 
 #include <iostream>
+#include <iterator>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -41,6 +43,24 @@ namespace {
         }
         return true;
     }
+
+    // Counts the copies and moves so we can check that elements are constructed in place.
+    struct Tracked {
+        static int copies;
+        static int moves;
+
+        int     id;
+        string  name;
+
+        Tracked(int i, const string& n) : id(i), name(n) {}
+        Tracked(const Tracked& t) : id(t.id), name(t.name) { ++copies; }
+        Tracked(Tracked&& t) noexcept : id(t.id), name(std::move(t.name)) { ++moves; }
+
+        bool operator==(const Tracked& rhs) const { return id == rhs.id && name == rhs.name; }
+    };
+
+    int Tracked::copies = 0;
+    int Tracked::moves = 0;
 }
 
 
@@ -243,6 +263,168 @@ static TestSuite ts("containers::CircularArray", {
             }
         }
     }),
+    make_pair("power of two capacity", [] {
+        using pow2_array_t = CircularArray<int, allocator<int>, PowerOfTwoCapacity>;
+        pow2_array_t ca(5);
+        KSS_ASSERT(ca.capacity() == 8 && ca.empty());
+        KSS_ASSERT(pow2_array_t(8).capacity() == 8);
+        KSS_ASSERT(pow2_array_t(9).capacity() == 16);
+
+        for (int i = 0; i < 8; ++i) { ca.push_back(i); }
+        KSS_ASSERT(throwsException<length_error>([&] { ca.push_back(8); }));
+        for (int i = 8; i < 100; ++i) {
+            ca.pop_front();
+            ca.push_back(i);
+            KSS_ASSERT(ca.front() == i-7 && ca.back() == i && ca[3] == i-4 && ca.at(7) == i);
+        }
+        ca.pop_back();
+        ca.push_front(91);
+        KSS_ASSERT(ca.front() == 91 && ca.back() == 98 && ca.size() == 8);
+
+        pow2_array_t ca2(ca.begin(), ca.end());
+        KSS_ASSERT(ca2 == ca);
+
+        ca.resize(3);
+        ca.shrink_to_fit();
+        KSS_ASSERT(ca.capacity() == 4 && ca.size() == 3);
+        KSS_ASSERT(ca[0] == 91 && ca[1] == 92 && ca[2] == 93);
+
+        ca.reserve(20);
+        KSS_ASSERT(ca.capacity() == 32 && ca.size() == 3);
+        KSS_ASSERT(ca[0] == 91 && ca[1] == 92 && ca[2] == 93);
+    }),
+    make_pair("contiguous spans", [] {
+        CircularArray<int> ca(8);
+        KSS_ASSERT(ca.array_one().second == 0 && ca.array_two().second == 0);
+
+        const vector<int> in { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+        ca.append(in.begin(), in.begin()+6);
+        KSS_ASSERT(ca.array_one().first == &ca.front() && ca.array_one().second == 6);
+        KSS_ASSERT(ca.array_two().second == 0);
+
+        vector<int> out;
+        ca.consume(4, back_inserter(out));
+        KSS_ASSERT(out == vector<int>({ 1, 2, 3, 4 }));
+        KSS_ASSERT(ca.size() == 2 && ca.front() == 5);
+
+        KSS_ASSERT(throwsException<length_error>([&] { ca.append(in.begin(), in.end()); }));
+        KSS_ASSERT(ca.size() == 2 && ca.front() == 5 && ca.back() == 6);
+
+        ca.append(in.begin()+6, in.end());
+        ca.append(in.begin(), in.begin()+2);
+        KSS_ASSERT(ca.size() == 8);
+        const auto& cca = ca;
+        KSS_ASSERT(cca.array_one().first == &cca.front() && cca.array_one().second == 4);
+        KSS_ASSERT(cca.array_two().first == &cca.back()-3 && cca.array_two().second == 4);
+        KSS_ASSERT(ca == CircularArray<int>({ 5, 6, 7, 8, 9, 10, 1, 2 }));
+
+        int buffer[8];
+        KSS_ASSERT(throwsException<invalid_argument>([&] { ca.consume(9, buffer); }));
+        KSS_ASSERT(ca.consume(8, buffer) == buffer+8);
+        KSS_ASSERT(ca.empty() && buffer[0] == 5 && buffer[4] == 9 && buffer[7] == 2);
+
+        CircularArray<string> cas(4);
+        cas.push_back("zero");
+        cas.pop_front();
+        istringstream strm("one two three four five");
+        KSS_ASSERT(throwsException<length_error>([&] {
+            cas.append(istream_iterator<string>(strm), istream_iterator<string>());
+        }));
+        KSS_ASSERT(cas == CircularArray<string>({ "one", "two", "three", "four" }));
+        KSS_ASSERT(cas.array_one().second == 3 && cas.array_two().second == 1);
+
+        vector<string> sout;
+        cas.consume(3, back_inserter(sout));
+        const vector<string> more { "five", "six" };
+        cas.append(more.begin(), more.end());
+        KSS_ASSERT(sout == vector<string>({ "one", "two", "three" }));
+        KSS_ASSERT(cas == CircularArray<string>({ "four", "five", "six" }));
+    }),
+    make_pair("emplace and moves", [] {
+        Tracked::copies = Tracked::moves = 0;
+        CircularArray<Tracked> ca(2);
+        ca.emplace_back(1, "one");
+        ca.emplace_front(0, "zero");
+        KSS_ASSERT(Tracked::copies == 0 && Tracked::moves == 0);
+        KSS_ASSERT(ca.front().id == 0 && ca.back().name == "one");
+        KSS_ASSERT(throwsException<length_error>([&] { ca.emplace_back(2, "two"); }));
+        KSS_ASSERT(ca.size() == 2);
+
+        ca.reserve(4);
+        KSS_ASSERT(Tracked::copies == 0 && Tracked::moves == 2);
+        ca.push_back(Tracked(2, "two"));
+        KSS_ASSERT(Tracked::copies == 0 && Tracked::moves == 3);
+
+        const Tracked t(3, "three");
+        ca.push_back(t);
+        KSS_ASSERT(Tracked::copies == 1 && Tracked::moves == 3);
+        KSS_ASSERT(ca[0].id == 0 && ca[1].id == 1 && ca[2].id == 2 && ca[3].id == 3);
+
+        ca.pop_back();
+        ca.shrink_to_fit();
+        ca.resize(5, t);
+        KSS_ASSERT(Tracked::copies == 3 && Tracked::moves == 9);
+        KSS_ASSERT(ca.size() == 5 && ca[2].name == "two" && ca[4].name == "three");
+    }),
+    make_pair("overwriting mode", [] {
+        CircularArray<string> ca(3);
+        KSS_ASSERT(!ca.overwriting() && ca.evictions() == 0);
+        ca.set_overwriting(true);
+        KSS_ASSERT(ca.overwriting());
+
+        ca.push_back("one");
+        ca.push_back("two");
+        ca.push_back("three");
+        ca.push_back("four");
+        ca.emplace_back(4, 'x');
+        KSS_ASSERT(ca == CircularArray<string>({ "three", "four", "xxxx" }));
+        KSS_ASSERT(ca.capacity() == 3 && ca.evictions() == 2);
+
+        ca.push_front("two");
+        KSS_ASSERT(ca == CircularArray<string>({ "two", "three", "four" }));
+        KSS_ASSERT(ca.evictions() == 3);
+
+        const vector<string> v { "a", "b", "c", "d", "e" };
+        ca.append(v.begin(), v.begin()+2);
+        KSS_ASSERT(ca == CircularArray<string>({ "four", "a", "b" }) && ca.evictions() == 5);
+        ca.append(v.begin(), v.end());
+        KSS_ASSERT(ca == CircularArray<string>({ "c", "d", "e" }) && ca.evictions() == 10);
+
+        ca.reset_evictions();
+        ca.assign(v.begin(), v.end());
+        KSS_ASSERT(ca == CircularArray<string>({ "c", "d", "e" }) && ca.capacity() == 3);
+        ca.assign(size_t(5), "z");
+        KSS_ASSERT(ca == CircularArray<string>({ "z", "z", "z" }) && ca.capacity() == 3);
+        ca.assign({ "p", "q", "r", "s" });
+        KSS_ASSERT(ca == CircularArray<string>({ "q", "r", "s" }) && ca.capacity() == 3);
+        KSS_ASSERT(ca.evictions() == 5);
+
+        CircularArray<string> ca2(ca, 3);
+        KSS_ASSERT(ca2.overwriting() && ca2.evictions() == 5);
+        CircularArray<string> ca3;
+        ca3.swap(ca2);
+        KSS_ASSERT(ca3.overwriting() && !ca2.overwriting());
+        ca3.push_back("t");
+        KSS_ASSERT(ca3 == CircularArray<string>({ "r", "s", "t" }) && ca3.evictions() == 6);
+
+        // The new element may refer to the one being evicted. (Long strings so that
+        // the values are not stored inline.)
+        const string first(40, 'f'), middle(40, 'm'), last(40, 'l');
+        CircularArray<string> ca4({ first, middle, last }, 3);
+        ca4.set_overwriting(true);
+        ca4.push_back(ca4.front());
+        KSS_ASSERT(ca4 == CircularArray<string>({ middle, last, first }));
+        ca4.push_front(ca4.back());
+        KSS_ASSERT(ca4 == CircularArray<string>({ first, middle, last }));
+        ca4.emplace_back(ca4.front());
+        ca4.emplace_front(std::move(ca4.back()));
+        KSS_ASSERT(ca4 == CircularArray<string>({ first, middle, last }));
+        KSS_ASSERT(ca4.evictions() == 4);
+
+        ca.set_overwriting(false);
+        KSS_ASSERT(throwsException<length_error>([&] { ca.push_back("t"); }));
+        KSS_ASSERT(ca == CircularArray<string>({ "q", "r", "s" }));
+    }),
     make_pair("relational operators", [] {
         CircularArray<int> ca { 1, 2, 3, 4, 5 };
         CircularArray<int> caeq(ca);
@@ -0,0 +1,198 @@
+//
+//  circular_queue.cpp
+//  unittest
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <kss/test/all.h>
+#include <kss/util/circular_queue.hpp>
+
+using namespace std;
+using namespace kss::util::containers;
+using namespace kss::test;
+
+
+static TestSuite ts("containers::CircularQueue", {
+    make_pair("spsc basic operations", [] {
+        SpscCircularQueue<string> q(3);
+        KSS_ASSERT(q.capacity() == 3 && q.size() == 0 && q.empty());
+
+        string s("two");
+        KSS_ASSERT(q.try_push("one"));
+        KSS_ASSERT(q.try_push(std::move(s)));
+        KSS_ASSERT(q.try_emplace(5, 'x'));
+        KSS_ASSERT(!q.try_push("four"));
+        KSS_ASSERT(q.size() == 3 && !q.empty());
+
+        string val;
+        KSS_ASSERT(q.try_pop(val) && val == "one");
+        KSS_ASSERT(q.try_push("four"));
+        KSS_ASSERT(q.try_pop(val) && val == "two");
+        KSS_ASSERT(q.try_pop(val) && val == "xxxxx");
+        KSS_ASSERT(q.try_pop(val) && val == "four");
+        KSS_ASSERT(!q.try_pop(val) && val == "four");
+        KSS_ASSERT(q.empty());
+
+        KSS_ASSERT(throwsException<invalid_argument>([] {
+            SpscCircularQueue<int> q2(0);
+        }));
+    }),
+    make_pair("spsc batch operations", [] {
+        SpscCircularQueue<int> q(10);
+        vector<int> in { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+        KSS_ASSERT(q.try_push_n(in.begin(), 6) == 6);
+        KSS_ASSERT(q.try_push_n(in.begin()+6, 6) == 4);
+        KSS_ASSERT(q.size() == 10);
+
+        vector<int> out;
+        KSS_ASSERT(q.try_pop_n(back_inserter(out), 7) == 7);
+        KSS_ASSERT(q.try_push_n(in.begin()+10, 2) == 2);
+        KSS_ASSERT(q.try_pop_n(back_inserter(out), 20) == 5);
+        KSS_ASSERT(out == in);
+        KSS_ASSERT(q.try_pop_n(back_inserter(out), 1) == 0);
+    }),
+    make_pair("spsc threaded", [] {
+        const int n = 100000;
+        SpscCircularQueue<int> q(64);
+        thread producer([&] {
+            int buffer[16];
+            int i = 0;
+            while (i < n) {
+                if ((i % 3) == 0) {
+                    if (q.try_push(i)) { ++i; }
+                }
+                else {
+                    const int batch = std::min(16, n - i);
+                    for (int j = 0; j < batch; ++j) { buffer[j] = i + j; }
+                    i += int(q.try_push_n(buffer, size_t(batch)));
+                }
+                this_thread::yield();
+            }
+        });
+
+        bool inOrder = true;
+        int expected = 0;
+        int buffer[32];
+        while (expected < n) {
+            const auto count = q.try_pop_n(buffer, 32);
+            for (size_t j = 0; j < count; ++j) {
+                if (buffer[j] != expected++) { inOrder = false; }
+            }
+        }
+        producer.join();
+        KSS_ASSERT(inOrder);
+        KSS_ASSERT(q.empty());
+    }),
+    make_pair("mpmc basic operations", [] {
+        MpmcCircularQueue<string> q(3);
+        KSS_ASSERT(q.capacity() == 3 && q.size() == 0 && q.empty());
+
+        string s("two");
+        KSS_ASSERT(q.try_push("one"));
+        KSS_ASSERT(q.try_push(std::move(s)));
+        KSS_ASSERT(q.try_emplace(5, 'x'));
+        KSS_ASSERT(!q.try_push("four"));
+        KSS_ASSERT(q.size() == 3 && !q.empty());
+
+        string val;
+        KSS_ASSERT(q.try_pop(val) && val == "one");
+        q.push("four");
+        KSS_ASSERT(q.try_pop(val) && val == "two");
+        KSS_ASSERT(q.try_pop(val) && val == "xxxxx");
+        q.pop(val);
+        KSS_ASSERT(val == "four");
+        KSS_ASSERT(!q.try_pop(val) && val == "four");
+        KSS_ASSERT(q.empty());
+
+        KSS_ASSERT(throwsException<invalid_argument>([] {
+            MpmcCircularQueue<int> q2(0);
+        }));
+        KSS_ASSERT(throwsException<invalid_argument>([] {
+            MpmcCircularQueue<int> q2(1);
+        }));
+
+        // The smallest queue must not overwrite an unread element.
+        MpmcCircularQueue<int> q3(2);
+        int i = 0;
+        KSS_ASSERT(q3.try_push(1) && q3.try_push(2) && !q3.try_push(3));
+        KSS_ASSERT(q3.try_pop(i) && i == 1);
+        KSS_ASSERT(q3.try_push(3));
+        KSS_ASSERT(q3.try_pop(i) && i == 2);
+        KSS_ASSERT(q3.try_pop(i) && i == 3);
+        KSS_ASSERT(!q3.try_pop(i) && q3.empty());
+    }),
+    make_pair("mpmc threaded", [] {
+        const int numThreads = 4;
+        const int perThread = 25000;
+        MpmcCircularQueue<int> q(100);
+        atomic<long long> total { 0 };
+        atomic<int> received { 0 };
+
+        vector<thread> threads;
+        for (int t = 0; t < numThreads; ++t) {
+            threads.emplace_back([&] {
+                for (int i = 1; i <= perThread; ++i) {
+                    if (i % 2) { q.push(i); }
+                    else { while (!q.try_push(i)) { this_thread::yield(); } }
+                }
+            });
+            threads.emplace_back([&] {
+                for (int i = 0; i < perThread; ++i) {
+                    int val = 0;
+                    q.pop(val);
+                    total += val;
+                    ++received;
+                }
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+
+        const long long expected = (long long)numThreads * perThread * (perThread + 1) / 2;
+        KSS_ASSERT(received == numThreads * perThread);
+        KSS_ASSERT(total == expected);
+        KSS_ASSERT(q.empty());
+    }),
+    make_pair("mpmc threaded blocking", [] {
+        // A small capacity so that both sides spend most of their time asleep.
+        const int numThreads = 4;
+        const int perThread = 5000;
+        MpmcCircularQueue<int> q(4);
+        atomic<long long> total { 0 };
+        atomic<int> received { 0 };
+
+        vector<thread> threads;
+        for (int t = 0; t < numThreads; ++t) {
+            threads.emplace_back([&] {
+                for (int i = 1; i <= perThread; ++i) {
+                    q.push(i);
+                }
+            });
+            threads.emplace_back([&] {
+                for (int i = 0; i < perThread; ++i) {
+                    int val = 0;
+                    q.pop(val);
+                    total += val;
+                    ++received;
+                }
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+
+        const long long expected = (long long)numThreads * perThread * (perThread + 1) / 2;
+        KSS_ASSERT(received == numThreads * perThread);
+        KSS_ASSERT(total == expected);
+        KSS_ASSERT(q.empty());
+    })
+});
@@ -14,6 +14,7 @@
 #include <limits>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <kss/test/all.h>
 #include <kss/util/convert.hpp>
@@ -136,6 +137,108 @@ static TestSuite ts("strings::convert", {
         KSS_ASSERT(checkConvert("15", 15UL, true));
         KSS_ASSERT(checkConvert("15", 15ULL, true));
     }),
+    make_pair("ranges and views", [] {
+        const string s("12,-3.25,0x1f,010, 7 ,1e3,0x1p4,inf");
+        const char* p = s.data();
+        KSS_ASSERT(convert<int>(p, p + 2) == 12);
+        KSS_ASSERT(convert<double>(stringview_t(p + 3, 5)) == -3.25);
+        KSS_ASSERT(convert<long>(stringview_t(p + 9, 4)) == 31);
+        KSS_ASSERT(convert<unsigned>(stringview_t(p + 14, 3)) == 8);
+        KSS_ASSERT(convert<long long>(stringview_t(p + 18, 3)) == 7);
+        KSS_ASSERT(convert<float>(stringview_t(p + 22, 3)) == 1000.0F);
+        KSS_ASSERT(convert<double>(stringview_t(p + 26, 5)) == 16.0);
+        KSS_ASSERT(convert<long double>(stringview_t(p + 32, 3)) == numeric_limits<long double>::infinity());
+        KSS_ASSERT(convert<double>("0.1") == 0.1 && convert<float>("0.1") == 0.1F);
+        KSS_ASSERT(convert<double>("12345678901234567890123e-3") == 12345678901234567890.123);
+        KSS_ASSERT(convert<int>("15 and more") == 15);
+        KSS_ASSERT(convert<string>(stringview_t(p, 2)) == "12");
+        KSS_ASSERT(convert<chrono::seconds>(stringview_t("10s")) == 10s);
+
+        KSS_ASSERT(checkForSystemError([&]{ convert<int>(p + 2, p + 3); }));
+        KSS_ASSERT(checkForSystemError([]{ convert<double>(stringview_t("-")); }));
+        KSS_ASSERT(checkForSystemError([]{ convert<unsigned long>(stringview_t(" -1")); }));
+        KSS_ASSERT(checkForInvalidArgument([&]{ convert<int>(p, p); }));
+        KSS_ASSERT(checkForInvalidArgument([]{ convert<double>(stringview_t()); }));
+        KSS_ASSERT(checkForOverflowError([]{ convert<long>(stringview_t("99999999999999999999")); }));
+        KSS_ASSERT(checkForOverflowError([]{ convert<double>(stringview_t("1e999")); }));
+        const auto minLong = to_string(numeric_limits<long>::min());
+        KSS_ASSERT(convert<long>(stringview_t(minLong)) == numeric_limits<long>::min());
+    }),
+    make_pair("convertAll", [] {
+        const vector<stringview_t> input { "1", "", "x", "-2.5", "123456789012", "99999999999999999999" };
+        vector<double> doubles;
+        vector<size_t> errors;
+        KSS_ASSERT(convertAll(input, doubles, &errors) == 2);
+        KSS_ASSERT(doubles == vector<double>({ 1.0, 0.0, 0.0, -2.5, 123456789012.0, 1e20 }));
+        KSS_ASSERT(errors == vector<size_t>({ 1, 2 }));
+
+        long long longs[6];
+        errors.clear();
+        KSS_ASSERT(convertAll(input.data(), input.size(), longs, &errors) == 3);
+        KSS_ASSERT(longs[0] == 1 && longs[3] == -2 && longs[4] == 123456789012LL && longs[5] == 0);
+        KSS_ASSERT(errors == vector<size_t>({ 1, 2, 5 }));
+
+        int ints[6];
+        KSS_ASSERT(convertAll(input.data(), input.size(), ints) == 4);
+        KSS_ASSERT(convertAll<int>(nullptr, 0, nullptr) == 0);
+        KSS_ASSERT(checkForInvalidArgument([&]{ convertAll<int>(nullptr, 1, ints); }));
+
+        // Long digit runs, which are parsed eight at a time.
+        const vector<stringview_t> digits {
+            "1234567890123456789", "18446744073709551615", "18446744073709551616",
+            "0000000000000000000042", "12345678x9"
+        };
+        vector<unsigned long long> ulls;
+        errors.clear();
+        KSS_ASSERT(convertAll(digits, ulls, &errors) == 1 && errors == vector<size_t>({ 2 }));
+        KSS_ASSERT(ulls[0] == 1234567890123456789ULL && ulls[1] == numeric_limits<unsigned long long>::max());
+        KSS_ASSERT(ulls[3] == 042 && ulls[4] == 12345678);
+    }),
+    make_pair("toChars", [] {
+        char buf[maxToCharsLength];
+        auto str = [&](char* end) { return string(buf, end); };
+        KSS_ASSERT(str(toChars(buf, buf + sizeof(buf), 0)) == "0");
+        KSS_ASSERT(str(toChars(buf, buf + sizeof(buf), -42)) == "-42");
+        KSS_ASSERT(str(toChars(buf, buf + sizeof(buf), 1234567890123LL)) == "1234567890123");
+        KSS_ASSERT(str(toChars(buf, buf + sizeof(buf), numeric_limits<long long>::min()))
+                   == to_string(numeric_limits<long long>::min()));
+        KSS_ASSERT(str(toChars(buf, buf + sizeof(buf), numeric_limits<unsigned long long>::max()))
+                   == to_string(numeric_limits<unsigned long long>::max()));
+
+        KSS_ASSERT(str(toChars(buf, buf + sizeof(buf), 0.1)) == "0.1");
+        KSS_ASSERT(str(toChars(buf, buf + sizeof(buf), 0.1F)) == "0.1");
+        KSS_ASSERT(str(toChars(buf, buf + sizeof(buf), -12.5)) == "-12.5");
+        KSS_ASSERT(str(toChars(buf, buf + sizeof(buf), 100.0)) == "100");
+        KSS_ASSERT(str(toChars(buf, buf + sizeof(buf), -0.0)) == "-0");
+        KSS_ASSERT(str(toChars(buf, buf + sizeof(buf), 0.1 + 0.2)) == "0.30000000000000004");
+        KSS_ASSERT(str(toChars(buf, buf + sizeof(buf), 1e100)) == "1e+100");
+        KSS_ASSERT(str(toChars(buf, buf + sizeof(buf), 0.00001)) == "1e-05");
+        KSS_ASSERT(str(toChars(buf, buf + sizeof(buf), numeric_limits<double>::infinity())) == "inf");
+        KSS_ASSERT(str(toChars(buf, buf + sizeof(buf), 2.5L)) == "2.5");
+
+        bool ok = true;
+        for (double d : { 1.0 / 3.0, 2.0 / 3.0, 1e-300, 6.02214076e23, 123.456, -9.87654321e-7 }) {
+            if (convert<double>(stringview_t(buf, size_t(toChars(buf, buf + sizeof(buf), d) - buf))) != d) {
+                ok = false;
+            }
+        }
+        KSS_ASSERT(ok);
+
+        KSS_ASSERT(str(toChars(buf, buf + sizeof(buf), 10ms)) == "10ms");
+        KSS_ASSERT(str(toChars(buf, buf + sizeof(buf), chrono::minutes(-3))) == "-3min");
+        KSS_ASSERT(convert<chrono::hours>(str(toChars(buf, buf + sizeof(buf), 5h))) == 5h);
+
+        KSS_ASSERT(toChars(buf, buf + 2, 123) == nullptr);
+        KSS_ASSERT(toChars(buf, buf + 3, 1.25) == nullptr);
+        KSS_ASSERT(toChars(buf, buf + 3, 10ms) == nullptr);
+        KSS_ASSERT(toChars(buf, buf, -1) == nullptr);
+
+        string s("x=");
+        appendTo(s, 12);
+        s += ",y=";
+        appendTo(appendTo(s, 0.5), 250us);
+        KSS_ASSERT(s == "x=12,y=0.5250us");
+    }),
     make_pair("overflows", [] {
         // Note it is technically possible for int (and unsigned) to be the same size
         // as long long in which case overflows would not be possible and this test
@@ -0,0 +1,109 @@
+//
+//  csvtokenizer.cpp
+//  unittest
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <kss/test/all.h>
+#include <kss/util/csvtokenizer.hpp>
+
+#include "suppress.hpp"
+
+using namespace std;
+using namespace kss::util::strings;
+using namespace kss::test;
+
+namespace {
+    using records_t = vector<vector<string>>;
+
+    records_t parse(stringview_t s, char delim = ',') {
+        records_t records;
+        CsvTokenizer t(s, delim);
+        stringview_t field;
+        bool startRecord = true;
+        while (t.hasAnother()) {
+            t.next(field);
+            if (startRecord) {
+                records.emplace_back();
+            }
+            records.back().push_back(field.to_string());
+            startRecord = t.endOfRecord();
+        }
+        return records;
+    }
+}
+
+
+static TestSuite ts("strings::CsvTokenizer", {
+    make_pair("unquoted", [] {
+        KSS_ASSERT(parse("").empty());
+        KSS_ASSERT(parse("a") == records_t({ { "a" } }));
+        KSS_ASSERT(parse("a,b,c") == records_t({ { "a", "b", "c" } }));
+        KSS_ASSERT(parse(",") == records_t({ { "", "" } }));
+        KSS_ASSERT(parse("a,,b,") == records_t({ { "a", "", "b", "" } }));
+        KSS_ASSERT(parse("a,b\nc,d\n") == records_t({ { "a", "b" }, { "c", "d" } }));
+        KSS_ASSERT(parse("a,b\r\nc,d\r\n") == records_t({ { "a", "b" }, { "c", "d" } }));
+        KSS_ASSERT(parse("a\n\nb") == records_t({ { "a" }, { "" }, { "b" } }));
+        KSS_ASSERT(parse("a;b,c", ';') == records_t({ { "a", "b,c" } }));
+
+        // Unquoted fields are views into the input.
+        const string s("one,two");
+        CsvTokenizer t(s);
+        stringview_t sv;
+        KSS_ASSERT(t.next(sv) == "one" && sv.data() == s.data() && !t.endOfRecord());
+        KSS_ASSERT(t.next(sv) == "two" && sv.data() == s.data() + 4 && t.endOfRecord());
+        KSS_ASSERT(!t.hasAnother());
+        suppress(cerr, [&] {
+            KSS_ASSERT(terminates([&] { t.next(sv); }));
+        });
+    }),
+    make_pair("quoted", [] {
+        KSS_ASSERT(parse("\"a,b\",c") == records_t({ { "a,b", "c" } }));
+        KSS_ASSERT(parse("\"\"") == records_t({ { "" } }));
+        KSS_ASSERT(parse("\"line 1\nline 2\"\nx") == records_t({ { "line 1\nline 2" }, { "x" } }));
+        KSS_ASSERT(parse("\"say \"\"hi\"\"\",\"\"\"\"\r\n") == records_t({ { "say \"hi\"", "\"" } }));
+        KSS_ASSERT(parse("a,\"b\"\r\n\"c\",") == records_t({ { "a", "b" }, { "c", "" } }));
+
+        // Only fields with escapes are copied.
+        const string s("\"a,b\",\"c\"\"d\"");
+        CsvTokenizer t(s);
+        stringview_t sv;
+        KSS_ASSERT(t.next(sv) == "a,b" && sv.data() == s.data() + 1);
+        KSS_ASSERT(t.next(sv) == "c\"d" && (sv.data() < s.data() || sv.data() >= s.data() + s.size()));
+
+        vector<string> fields;
+        CsvTokenizer t2(s);
+        for (const auto& field : t2) {
+            fields.push_back(field.to_string());
+        }
+        KSS_ASSERT(fields == vector<string>({ "a,b", "c\"d" }));
+    }),
+    make_pair("errors", [] {
+        KSS_ASSERT(throwsException<invalid_argument>([] { parse("\"abc"); }));
+        KSS_ASSERT(throwsException<invalid_argument>([] { parse("a,\"b\"\"\n"); }));
+        KSS_ASSERT(throwsException<invalid_argument>([] { parse("\"a\"b,c"); }));
+        KSS_ASSERT(throwsException<invalid_argument>([] { CsvTokenizer t("a", ',', ','); }));
+        KSS_ASSERT(throwsException<invalid_argument>([] { CsvTokenizer t("a", '\n'); }));
+
+        // A failed field leaves the tokenizer where it was.
+        CsvTokenizer t("a,\"b");
+        stringview_t sv;
+        KSS_ASSERT(t.next(sv) == "a");
+        KSS_ASSERT(throwsException<invalid_argument>([&] { t.next(sv); }));
+        KSS_ASSERT(t.hasAnother() && !t.endOfRecord());
+
+        // Including the field and the buffer of a copied field.
+        CsvTokenizer t2("\"a\"\"b\",\"c\"\"d\"e");
+        KSS_ASSERT(t2.next(sv) == "a\"b");
+        KSS_ASSERT(throwsException<invalid_argument>([&] { t2.next(sv); }));
+        KSS_ASSERT(sv == "a\"b");
+        KSS_ASSERT(t2.hasAnother() && !t2.endOfRecord());
+    })
+});
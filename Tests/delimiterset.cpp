@@ -0,0 +1,78 @@
+//
+//  delimiterset.cpp
+//  unittest
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+
+#include <string>
+
+#include <kss/test/all.h>
+#include <kss/util/delimiterset.hpp>
+
+using namespace std;
+using namespace kss::util::strings;
+using namespace kss::test;
+
+namespace {
+    // Check find against find_first_of for a delimiter at each position of a string
+    // that is long enough to cover full vector blocks and a partial final block.
+    bool matchesFindFirstOf(const string& delims) {
+        const DelimiterSet ds(delims);
+        for (size_t len = 0; len < 80; ++len) {
+            string s(len, 'x');
+            if (ds.find(s) != stringview_t::npos) {
+                return false;
+            }
+            for (size_t pos = 0; pos < len; ++pos) {
+                for (char d : delims) {
+                    string s2(s);
+                    s2[pos] = d;
+                    if (pos + 2 < len) {
+                        s2[pos + 2] = delims[0];
+                    }
+                    const auto expected = s2.find_first_of(delims);
+                    if (ds.find(s2) != expected || ds.find(s2, pos + 1) != s2.find_first_of(delims, pos + 1)) {
+                        return false;
+                    }
+                    if (ds.find(s2.data(), s2.data() + pos) != s2.data() + pos) {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+}
+
+
+static TestSuite ts("strings::DelimiterSet", {
+    make_pair("construction", [] {
+        DelimiterSet empty;
+        KSS_ASSERT(empty.empty() && empty.size() == 0 && !empty.contains(' '));
+        KSS_ASSERT(empty.find(stringview_t("a b c")) == stringview_t::npos);
+
+        DelimiterSet ds(" \t\n \t");
+        KSS_ASSERT(!ds.empty() && ds.size() == 3);
+        KSS_ASSERT(ds.contains(' ') && ds.contains('\t') && ds.contains('\n') && !ds.contains('x'));
+
+        DelimiterSet high(string("\0\xff\x80", 3));
+        KSS_ASSERT(high.size() == 3 && high.contains('\0') && high.contains('\xff') && high.contains('\x80'));
+        KSS_ASSERT(!high.contains('\x7f') && !high.contains('\x01'));
+    }),
+    make_pair("find", [] {
+        DelimiterSet ds(",;");
+        KSS_ASSERT(ds.find(stringview_t("a,b;c")) == 1 && ds.find(stringview_t("a,b;c"), 2) == 3);
+        KSS_ASSERT(ds.find(stringview_t("a,b;c"), 4) == stringview_t::npos);
+        KSS_ASSERT(ds.find(stringview_t("a,b;c"), 5) == stringview_t::npos);
+        KSS_ASSERT(ds.find(stringview_t()) == stringview_t::npos);
+
+        KSS_ASSERT(matchesFindFirstOf(","));
+        KSS_ASSERT(matchesFindFirstOf(" \t\r\n"));
+        KSS_ASSERT(matchesFindFirstOf(string("\0\xff", 2)));
+        KSS_ASSERT(matchesFindFirstOf("abcdefgh"));
+        KSS_ASSERT(matchesFindFirstOf("abcdefghijklmnop"));
+    })
+});
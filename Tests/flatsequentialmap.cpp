@@ -0,0 +1,163 @@
+//
+//  flatsequentialmap.cpp
+//  unittest
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <kss/test/all.h>
+#include <kss/util/flatsequentialmap.hpp>
+#include <kss/util/stringview.hpp>
+
+using namespace std;
+using namespace kss::util::containers;
+using namespace kss::util::strings;
+using namespace kss::test;
+
+namespace {
+    using map_t = FlatSequentialMap<string, int>;
+
+    const vector<pair<string, int>> items {
+        make_pair("this", 1),
+        make_pair("is", 2),
+        make_pair("a", 3),
+        make_pair("test", 4)
+    };
+
+    template <class Map>
+    bool matches(const Map& m, const vector<pair<string, int>>& expected) {
+        if (m.size() != expected.size()) {
+            return false;
+        }
+        return equal(m.begin(), m.end(), expected.begin(), [](const typename Map::const_reference& a, const pair<string, int>& b) {
+            return a.first == b.first && a.second == b.second;
+        });
+    }
+}
+
+
+static TestSuite ts("containers::FlatSequentialMap", {
+    make_pair("basic tests", [] {
+        map_t m;
+        KSS_ASSERT(m.empty() && m.size() == 0 && m.begin() == m.end());
+        m.insert(items.begin(), items.end());
+        KSS_ASSERT(!m.empty() && matches(m, items));
+        KSS_ASSERT(m.keys() == vector<string>({ "this", "is", "a", "test" }));
+        KSS_ASSERT(m.values() == vector<int>({ 1, 2, 3, 4 }));
+
+        auto p = m.insert(make_pair("is", 20));
+        KSS_ASSERT(!p.second && p.first->first == "is" && p.first->second == 2);
+        p = m.insert(make_pair("more", 5));
+        KSS_ASSERT(p.second && p.first == m.begin() + 4 && p.first.value() == 5);
+
+        KSS_ASSERT(m["a"] == 3 && (m["x"] = 6) == 6 && m.size() == 6);
+        KSS_ASSERT(m.at("x") == 6 && m.count("x") == 1 && m.count("notthere") == 0);
+        KSS_ASSERT(throwsException<out_of_range>([&] { m.at("notthere"); }));
+        const map_t& cm = m;
+        KSS_ASSERT(cm.at("test") == 4 && cm.find("this") == cm.begin() && cm.find("notthere") == cm.end());
+
+        m.find("test")->second = 40;
+        (*m.find("a")).second = 30;
+        KSS_ASSERT(m.at("test") == 40 && m.at("a") == 30);
+
+        map_t m2(m);
+        KSS_ASSERT(m2.size() == 6 && m2.at("x") == 6);
+        map_t m3(std::move(m2));
+        KSS_ASSERT(m3.size() == 6 && m3.at("more") == 5);
+        swap(m2, m3);
+        KSS_ASSERT(m3.empty() && m2.size() == 6);
+        m2.clear();
+        KSS_ASSERT(m2.empty() && m2.count("x") == 0 && m2.begin() == m2.end());
+        m2["y"] = 1;
+        KSS_ASSERT(m2.size() == 1 && m2.at("y") == 1);
+    }),
+    make_pair("iterators", [] {
+        map_t m(items.begin(), items.end());
+        map_t::iterator it = m.begin();
+        map_t::const_iterator cit = it;
+        KSS_ASSERT(cit == it && it == cit && it + 4 == m.cend() && m.end() - cit == 4);
+        KSS_ASSERT(it[2].first == "a" && (it + 3).key() == "test" && (2 + it)->second == 3);
+        KSS_ASSERT(it < m.end() && m.cend() > it && it <= cit && it >= cit);
+        ++it;
+        it++;
+        KSS_ASSERT(it->first == "a" && (--it)->first == "is");
+        it += 2;
+        it -= 1;
+        KSS_ASSERT(it.key() == "a");
+
+        vector<string> keys;
+        for (auto rit = m.rbegin(); rit != m.rend(); ++rit) {
+            keys.push_back(rit->first);
+        }
+        KSS_ASSERT(keys == vector<string>({ "test", "a", "is", "this" }));
+
+        vector<pair<string, int>> copied(m.cbegin(), m.cend());
+        KSS_ASSERT(copied == items);
+    }),
+    make_pair("erase", [] {
+        map_t m(items.begin(), items.end());
+        m["x"] = 5;
+        KSS_ASSERT(m.erase("notthere") == 0 && m.size() == 5);
+        KSS_ASSERT(m.erase("is") == 1 && m.count("is") == 0);
+        KSS_ASSERT(matches(m, { make_pair("this", 1), make_pair("a", 3), make_pair("test", 4), make_pair("x", 5) }));
+        KSS_ASSERT(m.at("x") == 5 && m.at("test") == 4);
+
+        auto it = m.erase(m.find("this"), m.find("x"));
+        KSS_ASSERT(it == m.begin() && it->first == "x" && matches(m, { make_pair("x", 5) }));
+        KSS_ASSERT(m.at("x") == 5 && m.count("a") == 0);
+        KSS_ASSERT(throwsException<invalid_argument>([&] { m.erase(m.end(), m.begin()); }));
+
+        m.erase(m.begin());
+        KSS_ASSERT(m.empty());
+        m.insert(make_pair("is", 2));
+        KSS_ASSERT(m.size() == 1 && m.at("is") == 2);
+    }),
+    make_pair("transparent lookup", [] {
+        FlatSequentialMap<string, int, StringHash, equal_to<>> m(items.begin(), items.end());
+        string s("this is a test");
+        stringview_t sv(s.data() + 10, 4);
+        KSS_ASSERT(m.find("is")->second == 2 && m.count(sv) == 1 && m.at(sv) == 4);
+        KSS_ASSERT(m.find(stringview_t("notthere")) == m.end());
+        KSS_ASSERT(throwsException<out_of_range>([&] { m.at(stringview_t("notthere")); }));
+    }),
+    make_pair("vs unordered_map", [] {
+        // Exercise the growth and the backward shift deletion by comparing against
+        // a reference implementation.
+        FlatSequentialMap<int, int> m;
+        unordered_map<int, int> ref;
+        vector<int> order;
+        mt19937 gen(1234);
+        uniform_int_distribution<int> keys(0, 2000);
+        bool ok = true;
+        for (int i = 0; i < 20000; ++i) {
+            const int k = keys(gen);
+            if (i % 3 == 0) {
+                if (m.erase(k) != ref.erase(k)) { ok = false; }
+                order.erase(remove(order.begin(), order.end(), k), order.end());
+            }
+            else {
+                if (m.insert(make_pair(k, i)).second) {
+                    order.push_back(k);
+                    ref[k] = i;
+                }
+            }
+        }
+        KSS_ASSERT(ok && m.size() == ref.size() && m.keys() == order);
+        for (int k = 0; k <= 2000; ++k) {
+            const auto it = ref.find(k);
+            if (it == ref.end() ? m.count(k) != 0 : m.at(k) != it->second) { ok = false; }
+        }
+        KSS_ASSERT(ok);
+    })
+});
@@ -11,6 +11,8 @@
 
 #include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <numeric>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -472,9 +474,78 @@ static void testCopyRandomAccessIterator() {
     }
 }
 
+static void testCircularIterator() {
+    // The ring is stored in v starting at slot 3, so the logical order is 4, 5, 1, 2, 3.
+    using iterator = CircularIterator<vector<int>>;
+    using const_iterator = ConstCircularIterator<vector<int>>;
+    {   // Basic tests.
+        vector<int> v = { 1, 2, 3, 4, 5 };
+        iterator first(v.data(), v.size(), 3, 0);
+        iterator last(v.data(), v.size(), 3, 5);
+        const int expected[] = { 4, 5, 1, 2, 3 };
+        int i = 0;
+        for (iterator it = first; it != last; ++it) {
+            KSS_ASSERT(*it == expected[i++]);
+        }
+        KSS_ASSERT(i == 5);
+        KSS_ASSERT((last - first) == 5 && (first - last) == -5);
+        KSS_ASSERT(first < last && last > first && first <= first);
+
+        i = 5;
+        for (iterator it = last; it != first; ) {
+            --it;
+            KSS_ASSERT(*it == expected[--i]);
+        }
+    }
+    {   // Test random access.
+        vector<int> v = { 1, 2, 3, 4, 5 };
+        iterator first(v.data(), v.size(), 3, 0);
+        iterator it = first + 3;
+        KSS_ASSERT(*it == 2 && (it - first) == 3);
+        KSS_ASSERT(*(it - 3) == 4 && *(it - 1) == 1 && *(1 + it) == 3);
+        KSS_ASSERT(first[0] == 4 && first[1] == 5 && first[2] == 1 && first[4] == 3);
+        it -= 2;
+        KSS_ASSERT(*it == 5);
+        it += 3;
+        KSS_ASSERT(*it == 3);
+        it++;
+        KSS_ASSERT(it == iterator(v.data(), v.size(), 3, 5));
+        first[2] = -1;
+        KSS_ASSERT(v[0] == -1);
+    }
+    {   // Test the const version, conversions and swapping.
+        vector<pair<string, int>> v = { make_pair("one", 1), make_pair("two", 2), make_pair("three", 3) };
+        using pair_iterator = CircularIterator<vector<pair<string, int>>>;
+        using const_pair_iterator = ConstCircularIterator<vector<pair<string, int>>>;
+        iterator_traits<const_pair_iterator>::reference r = *const_pair_iterator(v.data(), v.size(), 2, 0);
+        KSS_ASSERT(r.first == "three");
+
+        pair_iterator it(v.data(), v.size(), 2, 0);
+        const_pair_iterator cit(it);
+        ++it;
+        KSS_ASSERT(it->second == 1 && cit->second == 3);
+        KSS_ASSERT(std::distance(cit, const_pair_iterator(it)) == 1);
+
+        pair_iterator it2;
+        swap(it, it2);
+        KSS_ASSERT(it2->first == "one");
+    }
+    {   // Test with the standard algorithms.
+        vector<int> v = { 1, 2, 3, 4, 5 };
+        const_iterator first(v.data(), v.size(), 3, 0);
+        const_iterator last(v.data(), v.size(), 3, 5);
+        vector<int> out;
+        copy(first, last, back_inserter(out));
+        KSS_ASSERT(out == vector<int>({ 4, 5, 1, 2, 3 }));
+        KSS_ASSERT(*max_element(first, last) == 5);
+        KSS_ASSERT(accumulate(reverse_iterator<const_iterator>(last), reverse_iterator<const_iterator>(first), 0) == 15);
+    }
+}
+
 static NoParallelTestSuite ts("iterators::iterator", {
     make_pair("ForwardIterator", testForwardIterator),
     make_pair("RandomAccessIterator", testRandomAccessIterator),
     make_pair("ConstRandomAccessIterator", testConstRandomAccessIterator),
-    make_pair("CopyRandomAccessIterator", testCopyRandomAccessIterator)
+    make_pair("CopyRandomAccessIterator", testCopyRandomAccessIterator),
+    make_pair("CircularIterator", testCircularIterator)
 });
@@ -0,0 +1,97 @@
+//
+//  patternmatcher.cpp
+//  unittest
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <kss/test/all.h>
+#include <kss/util/patternmatcher.hpp>
+#include <kss/util/stringutil.hpp>
+
+using namespace std;
+using namespace kss::util::strings;
+using namespace kss::test;
+
+namespace {
+    using matches_t = vector<pair<size_t, size_t>>;
+
+    matches_t findAll(const PatternMatcher& m, stringview_t s, bool allowOverlaps) {
+        matches_t matches;
+        m.find(s, allowOverlaps, [&](size_t pattern, size_t pos) {
+            matches.emplace_back(pattern, pos);
+        });
+        return matches;
+    }
+}
+
+
+static TestSuite ts("strings::PatternMatcher", {
+    make_pair("basic tests", [] {
+        PatternMatcher m({ "he", "she", "his", "hers" });
+        KSS_ASSERT(m.size() == 4);
+        KSS_ASSERT(findAll(m, "ushers", false) == matches_t({ { 1, 1 }, { 0, 2 }, { 3, 2 } }));
+        KSS_ASSERT(m.countEach("ushers his hero") == vector<size_t>({ 2, 1, 1, 1 }));
+        KSS_ASSERT(m.count("ushers his hero") == 5);
+        KSS_ASSERT(m.count("") == 0);
+        KSS_ASSERT(m.count("xyz") == 0);
+
+        // Overlaps are counted per pattern, as with countOccurrencesOf.
+        PatternMatcher aa({ "AA", "A" });
+        KSS_ASSERT(aa.countEach("AAAAA") == vector<size_t>({ 2, 5 }));
+        KSS_ASSERT(aa.countEach("AAAAA", true) == vector<size_t>({ 4, 5 }));
+        KSS_ASSERT(findAll(aa, "AAA", false) == matches_t({ { 1, 0 }, { 0, 0 }, { 1, 1 }, { 1, 2 } }));
+
+        // Repeated patterns, NULs and non-ASCII characters.
+        PatternMatcher b(vector<string>({ string("a\0b", 3), "\xc3\xa9", string("a\0b", 3) }));
+        KSS_ASSERT(b.countEach(string("xa\0b\xc3\xa9\xc3\xa9" "a\0", 10)) == vector<size_t>({ 1, 2, 1 }));
+
+        KSS_ASSERT(throwsException<invalid_argument>([] { PatternMatcher({ "a", "" }); }));
+    }),
+    make_pair("stream", [] {
+        PatternMatcher m({ "error", "warning", "rror" });
+        const string text = "an error, a warning, another error and errors";
+        const auto expected = findAll(m, text, false);
+
+        // Every way of splitting the text in two must give the same result.
+        for (size_t split = 0; split <= text.size(); ++split) {
+            PatternMatcher::Stream stream(m);
+            matches_t matches;
+            const auto fn = [&](size_t pattern, size_t pos) { matches.emplace_back(pattern, pos); };
+            stream.scan(stringview_t(text).substr(0, split), fn);
+            stream.scan(stringview_t(text).substr(split), fn);
+            KSS_ASSERT(matches == expected);
+            KSS_ASSERT(stream.counts() == m.countEach(text));
+            KSS_ASSERT(stream.position() == text.size());
+        }
+
+        PatternMatcher::Stream stream(m);
+        for (char ch : text) {
+            stream.scan(stringview_t(&ch, 1));
+        }
+        KSS_ASSERT(stream.counts() == vector<size_t>({ 3, 1, 3 }));
+        stream.reset();
+        KSS_ASSERT(stream.position() == 0 && stream.counts() == vector<size_t>({ 0, 0, 0 }));
+        stream.scan("rror");
+        KSS_ASSERT(stream.counts() == vector<size_t>({ 0, 0, 1 }));
+    }),
+    make_pair("agrees with countOccurrencesOf", [] {
+        const vector<string> patterns { "ab", "aba", "b", "bab", "abab", "ba", "c", "aaa", "aa" };
+        const PatternMatcher m(patterns);
+        for (const string s : { "", "a", "abababab", "aaaaaaa", "babcabcaabbaab", "cccabababaaab" }) {
+            for (bool allowOverlaps : { false, true }) {
+                const auto counts = m.countEach(s, allowOverlaps);
+                for (size_t i = 0; i < patterns.size(); ++i) {
+                    KSS_ASSERT(counts[i] == countOccurrencesOf(s, patterns[i], allowOverlaps));
+                }
+            }
+        }
+    })
+});
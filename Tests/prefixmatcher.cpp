@@ -0,0 +1,83 @@
+//
+//  prefixmatcher.cpp
+//  unittest
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+
+#include <string>
+#include <vector>
+
+#include <kss/test/all.h>
+#include <kss/util/prefixmatcher.hpp>
+#include <kss/util/stringutil.hpp>
+
+using namespace std;
+using namespace kss::util::strings;
+using namespace kss::test;
+
+
+static TestSuite ts("strings::PrefixMatcher", {
+    make_pair("basic tests", [] {
+        PrefixMatcher empty;
+        KSS_ASSERT(empty.empty() && empty.size() == 0);
+        KSS_ASSERT(!empty.matches("anything"));
+        KSS_ASSERT(!empty.matches(""));
+        KSS_ASSERT(empty.longestMatch("anything") == PrefixMatcher::npos);
+
+        PrefixMatcher m({ "/api/v1/users", "/api/v1/orders", "/api/", "/static", "/api/v1/users/" });
+        KSS_ASSERT(m.size() == 5 && !m.empty());
+        KSS_ASSERT(m.longestMatch("/api/v1/users/42") == 4);
+        KSS_ASSERT(m.longestMatch("/api/v1/users") == 0);
+        KSS_ASSERT(m.longestMatch("/api/v1/orders?id=1") == 1);
+        KSS_ASSERT(m.longestMatch("/api/v1/order") == 2);
+        KSS_ASSERT(m.longestMatch("/api/v2") == 2);
+        KSS_ASSERT(m.longestMatch("/static/logo.png") == 3);
+        KSS_ASSERT(m.longestMatch("/api") == PrefixMatcher::npos);
+        KSS_ASSERT(m.longestMatch("/stat") == PrefixMatcher::npos);
+        KSS_ASSERT(m.longestMatch("") == PrefixMatcher::npos);
+        KSS_ASSERT(m.matches("/api/anything") && m.matches("/static"));
+        KSS_ASSERT(!m.matches("/ap") && !m.matches("api/") && !m.matches(""));
+    }),
+    make_pair("special prefixes", [] {
+        // The empty prefix matches everything, but longer ones are preferred.
+        PrefixMatcher m({ "abc", "", "ab", "abc" });
+        KSS_ASSERT(m.longestMatch("") == 1);
+        KSS_ASSERT(m.longestMatch("xyz") == 1);
+        KSS_ASSERT(m.longestMatch("abx") == 2);
+        KSS_ASSERT(m.longestMatch("abcd") == 0);
+        KSS_ASSERT(m.matches("xyz"));
+
+        // Embedded NULs and bytes above 0x7f.
+        const vector<string> binary { string("a\0b", 3), string("a\0", 2), "\xff\xfe" };
+        PrefixMatcher b(binary);
+        KSS_ASSERT(b.longestMatch(string("a\0bc", 4)) == 0);
+        KSS_ASSERT(b.longestMatch(string("a\0c", 3)) == 1);
+        KSS_ASSERT(b.longestMatch("a") == PrefixMatcher::npos);
+        KSS_ASSERT(b.longestMatch("\xff\xfe\x01") == 2);
+    }),
+    make_pair("agrees with startsWith", [] {
+        // Enough distinct first characters to use the binary search.
+        vector<string> prefixes;
+        for (char c = 'a'; c <= 'z'; c += 2) {
+            for (const char* tail : { "", "x", "xy", "xyz", "q" }) {
+                prefixes.push_back(string(1, c) + tail);
+            }
+        }
+        PrefixMatcher m(prefixes);
+        for (const string s : { "", "a", "ax", "axy", "axyzzy", "aq", "ab", "b", "bx", "mxy", "z", "zxyz" }) {
+            size_t expected = PrefixMatcher::npos;
+            for (size_t i = 0; i < prefixes.size(); ++i) {
+                if (startsWith(s, prefixes[i])
+                    && (expected == PrefixMatcher::npos || prefixes[i].size() > prefixes[expected].size()))
+                {
+                    expected = i;
+                }
+            }
+            KSS_ASSERT(m.longestMatch(s) == expected);
+            KSS_ASSERT(m.matches(s) == (expected != PrefixMatcher::npos));
+        }
+    })
+});
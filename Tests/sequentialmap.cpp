@@ -9,15 +9,23 @@
 
 #include <algorithm>
 #include <iterator>
+#include <map>
+#include <random>
+#include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <kss/test/all.h>
 #include <kss/util/sequentialmap.hpp>
+#include <kss/util/stringview.hpp>
+#include <kss/util/substring.hpp>
 
 using namespace std;
 using namespace kss::util;
 using namespace kss::util::containers;
+using namespace kss::util::strings;
 using namespace kss::test;
 
 namespace {
@@ -31,9 +39,10 @@ namespace {
     };
 
 
-    void test_stage_1(SequentialMap<string, int>& m) {
+    template <class Map>
+    void test_stage_1(Map& m) {
 
-        const SequentialMap<string, int>& mref(m);
+        const Map& mref(m);
         KSS_ASSERT(!m.empty() && m.size() == 4);
         KSS_ASSERT(equal(m.begin(), m.end(), ar));
         KSS_ASSERT(equal(mref.begin(), mref.end(), ar));
@@ -44,6 +53,93 @@ namespace {
         KSS_ASSERT(equal(mref.rbegin(), mref.rend(), rit));
         KSS_ASSERT(equal(m.crbegin(), m.crend(), rit));
     }
+
+    // Value whose copy constructor throws once a given number of copies have been made.
+    struct ThrowingValue {
+        static int copiesUntilThrow;
+        int v = 0;
+
+        ThrowingValue(int val = 0) : v(val) {}
+        ThrowingValue(const ThrowingValue& tv) : v(tv.v) {
+            if (copiesUntilThrow >= 0 && copiesUntilThrow-- == 0) {
+                throw runtime_error("copy failed");
+            }
+        }
+        ThrowingValue& operator=(const ThrowingValue&) = default;
+    };
+    int ThrowingValue::copiesUntilThrow = -1;
+
+    // Restricts an iterator to a single pass input iterator.
+    template <class It>
+    struct InputOnly {
+        using iterator_category = input_iterator_tag;
+        using value_type = typename iterator_traits<It>::value_type;
+        using difference_type = typename iterator_traits<It>::difference_type;
+        using pointer = typename iterator_traits<It>::pointer;
+        using reference = typename iterator_traits<It>::reference;
+
+        It it;
+        reference operator*() const { return *it; }
+        InputOnly& operator++() { ++it; return *this; }
+        bool operator==(const InputOnly& rhs) const { return it == rhs.it; }
+        bool operator!=(const InputOnly& rhs) const { return it != rhs.it; }
+    };
+
+    template <class Map>
+    void test_bulk_insert() {
+        const vector<pair<string, int>> in {
+            make_pair("c", 1), make_pair("a", 2), make_pair("b", 3),
+            make_pair("a", 4), make_pair("d", 5), make_pair("c", 6)
+        };
+        Map smap(in.begin(), in.end());
+        const vector<pair<string, int>> expected1 {
+            make_pair("c", 1), make_pair("a", 2), make_pair("b", 3), make_pair("d", 5)
+        };
+        KSS_ASSERT(smap.size() == 4 && equal(smap.begin(), smap.end(), expected1.begin()));
+        KSS_ASSERT(smap.at("a") == 2 && smap.at("d") == 5 && smap.at("c") == 1);
+
+        // Keys already in the map are not replaced, and erased keys may be reused.
+        smap.erase("b");
+        smap.reserve(10);
+        const vector<pair<string, int>> in2 { make_pair("e", 7), make_pair("b", 8), make_pair("a", 9) };
+        smap.insert(in2.begin(), in2.end());
+        const vector<pair<string, int>> expected2 {
+            make_pair("c", 1), make_pair("a", 2), make_pair("d", 5), make_pair("e", 7), make_pair("b", 8)
+        };
+        KSS_ASSERT(smap.size() == 5 && equal(smap.begin(), smap.end(), expected2.begin()));
+        KSS_ASSERT(smap.at("b") == 8 && smap.at("e") == 7 && smap.count("a") == 1);
+
+        // Single pass input iterators and empty ranges.
+        using input_t = InputOnly<vector<pair<string, int>>::const_iterator>;
+        Map smap2;
+        smap2.insert(input_t { in.begin() }, input_t { in.end() });
+        smap2.insert(input_t { in.end() }, input_t { in.end() });
+        KSS_ASSERT(smap2.size() == 4 && equal(smap2.begin(), smap2.end(), expected1.begin()));
+    }
+
+    template <class Map>
+    void test_bulk_insert_rollback() {
+        vector<pair<int, ThrowingValue>> in;
+        for (int i = 0; i < 10; ++i) {
+            in.push_back(make_pair(i % 7, ThrowingValue(i)));
+        }
+        Map smap;
+        smap.insert(in.begin(), in.begin()+3);
+        ThrowingValue::copiesUntilThrow = 5;
+        KSS_ASSERT(throwsException<runtime_error>([&] { smap.insert(in.begin()+3, in.end()); }));
+        ThrowingValue::copiesUntilThrow = -1;
+        KSS_ASSERT(smap.size() == 3 && smap.count(3) == 0 && smap.at(2).v == 2);
+
+        smap.insert(in.begin()+3, in.end());
+        KSS_ASSERT(smap.size() == 7 && smap.at(0).v == 0 && smap.at(6).v == 6);
+        int i = 0;
+        bool ok = true;
+        for (const auto& p : smap) {
+            if (p.first != i || p.second.v != i) { ok = false; }
+            ++i;
+        }
+        KSS_ASSERT(ok);
+    }
 }
 
 
@@ -114,5 +210,180 @@ static TestSuite ts("containers::sequentialmap", {
         KSS_ASSERT(smap2.count("notthere") == 0);
         KSS_ASSERT(smap2.count("a") == 1);
         test_stage_1(smap2);
+    }),
+    make_pair("tombstone erase", [] {
+        SequentialMap<int, int> smap;
+        KSS_ASSERT(smap.compaction_threshold() == 0.5);
+        KSS_ASSERT(throwsException<invalid_argument>([&] { smap.set_compaction_threshold(1.5); }));
+        smap.set_compaction_threshold(1.0);
+        for (int i = 0; i < 10; ++i) { smap[i] = i * 10; }
+
+        smap.erase(0);
+        smap.erase(smap.find(5));
+        smap.erase(smap.find(7), smap.find(9));
+        KSS_ASSERT(smap.size() == 6 && smap.count(5) == 0 && smap.find(8) == smap.end());
+        KSS_ASSERT(smap.begin()->first == 1 && smap.rbegin()->first == 9);
+
+        vector<int> keys;
+        for (const auto& p : smap) { keys.push_back(p.first); }
+        KSS_ASSERT(keys == vector<int>({ 1, 2, 3, 4, 6, 9 }));
+        keys.clear();
+        for (auto it = smap.crbegin(); it != smap.crend(); ++it) { keys.push_back(it->first); }
+        KSS_ASSERT(keys == vector<int>({ 9, 6, 4, 3, 2, 1 }));
+
+        smap[5] = 55;
+        KSS_ASSERT(smap.size() == 7 && (--smap.end())->second == 55);
+        KSS_ASSERT(smap.at(6) == 60 && smap.at(9) == 90);
+        smap.compact();
+        KSS_ASSERT(smap.size() == 7 && smap.at(6) == 60 && smap.at(5) == 55);
+        keys.clear();
+        for (const auto& p : smap) { keys.push_back(p.first); }
+        KSS_ASSERT(keys == vector<int>({ 1, 2, 3, 4, 6, 9, 5 }));
+
+        // With a threshold of 1, compaction happens once everything is erased, after
+        // which new items reuse the start of the list.
+        {
+            SequentialMap<int, int> smap1;
+            smap1.set_compaction_threshold(1.0);
+            for (int i = 0; i < 5; ++i) { smap1[i] = i; }
+            const auto* firstItem = &*smap1.begin();
+            const auto* lastItem = &*smap1.find(4);
+            for (int i = 0; i < 4; ++i) { smap1.erase(i); }
+            KSS_ASSERT(smap1.size() == 1 && &*smap1.begin() == lastItem);
+            smap1.erase(4);
+            KSS_ASSERT(smap1.empty());
+            smap1[7] = 7;
+            KSS_ASSERT(smap1.size() == 1 && &*smap1.begin() == firstItem);
+        }
+
+        // Erase everything from the front, compacting along the way.
+        smap.set_compaction_threshold(0.25);
+        while (!smap.empty()) {
+            const int k = smap.begin()->first;
+            smap.erase(smap.begin());
+            KSS_ASSERT(smap.count(k) == 0);
+        }
+        KSS_ASSERT(smap.begin() == smap.end() && smap.size() == 0);
+
+        SequentialMap<int, int>::const_iterator cit = smap.begin();
+        KSS_ASSERT(cit == smap.cend());
+        smap[1] = 1;
+        SequentialMap<int, int> smap2(std::move(smap));
+        KSS_ASSERT(smap.empty() && smap2.size() == 1 && smap2.compaction_threshold() == 0.25);
+        smap[2] = 2;
+        KSS_ASSERT(smap.size() == 1 && smap.begin()->first == 2);
+        smap = std::move(smap2);
+        KSS_ASSERT(smap.size() == 1 && smap.begin()->first == 1 && smap2.empty());
+    }),
+    make_pair("tombstone erase with hash index", [] {
+        HashSequentialMap<int, int> smap;
+        map<int, int> ref;
+        mt19937 gen(4321);
+        uniform_int_distribution<int> keys(0, 500);
+        vector<int> order;
+        bool ok = true;
+        for (int i = 0; i < 5000; ++i) {
+            const int k = keys(gen);
+            if (i % 2) {
+                if (smap.erase(k) != ref.erase(k)) { ok = false; }
+                order.erase(remove(order.begin(), order.end(), k), order.end());
+            }
+            else if (smap.insert(make_pair(k, i)).second) {
+                ref[k] = i;
+                order.push_back(k);
+            }
+        }
+        KSS_ASSERT(ok && smap.size() == ref.size());
+        vector<int> actual;
+        for (const auto& p : smap) {
+            actual.push_back(p.first);
+            if (ref[p.first] != p.second) { ok = false; }
+        }
+        KSS_ASSERT(ok && actual == order);
+    }),
+    make_pair("hash index", [] {
+        HashSequentialMap<string, int> smap(ar, ar+4);
+        test_stage_1(smap);
+        KSS_ASSERT(smap["a"] == 3 && smap.size() == 4);
+        KSS_ASSERT((smap["x"] = 5) == 5 && smap.size() == 5);
+        KSS_ASSERT(!smap.insert(make_pair("x", 6)).second && smap.at("x") == 5);
+        KSS_ASSERT(throwsException<out_of_range>([&] { smap.at("notthere"); }));
+        KSS_ASSERT(smap.count("test") == 1 && smap.count("notthere") == 0);
+
+        smap.erase(smap.find("is"), smap.find("x"));
+        pair<string, int> ar2[] = { make_pair("this", 1), make_pair("x", 5) };
+        KSS_ASSERT(smap.size() == 2 && equal(smap.begin(), smap.end(), ar2));
+        KSS_ASSERT(smap.at("x") == 5 && smap.find("a") == smap.end());
+
+        HashSequentialMap<string, int> smap2;
+        swap(smap, smap2);
+        KSS_ASSERT(smap.empty() && smap2.size() == 2 && smap2.at("this") == 1);
+        smap2.clear();
+        KSS_ASSERT(smap2.empty() && smap2.count("this") == 0);
+    }),
+    make_pair("hash index vs unordered_map", [] {
+        // Exercise the growth and the backward shift deletion by comparing against
+        // a reference implementation.
+        HashSequentialMap<int, int> smap;
+        unordered_map<int, int> ref;
+        mt19937 gen(1234);
+        uniform_int_distribution<int> keys(0, 2000);
+        bool ok = true;
+        for (int i = 0; i < 20000; ++i) {
+            const int k = keys(gen);
+            if (i % 3 == 0) {
+                if (smap.erase(k) != ref.erase(k)) { ok = false; }
+            }
+            else {
+                smap[k] = i;
+                ref[k] = i;
+            }
+        }
+        KSS_ASSERT(ok && smap.size() == ref.size());
+        for (int k = 0; k <= 2000; ++k) {
+            const auto it = ref.find(k);
+            if (it == ref.end() ? smap.count(k) != 0 : smap.at(k) != it->second) { ok = false; }
+        }
+        KSS_ASSERT(ok);
+    }),
+    make_pair("transparent lookup", [] {
+        string s("this is a test");
+        substring_t ss(s, 5, 2);
+        stringview_t sv(s.data() + 10, 4);
+
+        SequentialMap<string, int, less<>> smap(ar, ar+4);
+        KSS_ASSERT(smap.find("this") == smap.begin() && smap.find("notthere") == smap.end());
+        KSS_ASSERT(smap.find(ss)->first == "is" && smap.count(sv) == 1 && smap.count(stringview_t("x")) == 0);
+        KSS_ASSERT(smap.at(sv) == 4 && smap.at("a") == 3);
+        KSS_ASSERT(throwsException<out_of_range>([&] { smap.at(stringview_t("notthere")); }));
+        const auto& csmap = smap;
+        KSS_ASSERT(csmap.find(sv)->second == 4 && csmap.at(ss) == 2);
+
+        HashSequentialMap<string, int, StringHash, equal_to<>> hmap(ar, ar+4);
+        KSS_ASSERT(hmap.find("this") == hmap.begin() && hmap.find("notthere") == hmap.end());
+        KSS_ASSERT(hmap.find(ss)->first == "is" && hmap.count(sv) == 1 && hmap.count(stringview_t("x")) == 0);
+        KSS_ASSERT(hmap.at(sv) == 4 && hmap.at("a") == 3 && hmap.at(string("is")) == 2);
+        KSS_ASSERT(throwsException<out_of_range>([&] { hmap.at(stringview_t("notthere")); }));
+        hmap.erase("is");
+        KSS_ASSERT(hmap.count(ss) == 0 && hmap.size() == 3);
+    }),
+    make_pair("bulk insert", [] {
+        test_bulk_insert<SequentialMap<string, int>>();
+        test_bulk_insert<HashSequentialMap<string, int>>();
+        test_bulk_insert_rollback<SequentialMap<int, ThrowingValue>>();
+        test_bulk_insert_rollback<HashSequentialMap<int, ThrowingValue>>();
+
+        // Large enough to exercise the hinted tree inserts and the hash reserve.
+        vector<pair<int, int>> in;
+        for (int i = 0; i < 5000; ++i) {
+            in.push_back(make_pair((i * 7919) % 4000, i));
+        }
+        SequentialMap<int, int> smap(in.begin(), in.end());
+        HashSequentialMap<int, int> hmap(in.begin(), in.end());
+        bool ok = (smap.size() == 4000 && hmap.size() == 4000);
+        for (int i = 0; i < 4000; ++i) {
+            if (smap.at((i * 7919) % 4000) != i || hmap.at((i * 7919) % 4000) != i) { ok = false; }
+        }
+        KSS_ASSERT(ok && equal(smap.begin(), smap.end(), in.begin()) && equal(hmap.begin(), hmap.end(), in.begin()));
     })
 });
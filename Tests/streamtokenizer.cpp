@@ -0,0 +1,106 @@
+//
+//  streamtokenizer.cpp
+//  unittest
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <unistd.h>
+
+#include <kss/test/all.h>
+#include <kss/util/streamtokenizer.hpp>
+#include <kss/util/tokenizer.hpp>
+
+#include "suppress.hpp"
+
+using namespace std;
+using namespace kss::util::strings;
+using namespace kss::test;
+
+namespace {
+    const vector<string> inputs {
+        "", " ", "  ", "a", "a ", " a", "a  b", "the quick brown fox",
+        "the  quick\nbrown\t\tfox ", "averyveryverylongtokenthatspanschunks and short ones ",
+    };
+
+    vector<string> expectedTokens(const string& s, const string& delims) {
+        Tokenizer t(s, delims);
+        vector<string> tokens;
+        for (const auto& token : t) {
+            tokens.push_back(token);
+        }
+        return tokens;
+    }
+
+    vector<string> streamTokens(StreamTokenizer& t) {
+        vector<string> tokens;
+        for (stringview_t sv : t) {
+            tokens.push_back(sv.to_string());
+        }
+        return tokens;
+    }
+}
+
+
+static TestSuite ts("strings::StreamTokenizer", {
+    make_pair("istream", [] {
+        bool ok = true;
+        for (const auto& s : inputs) {
+            for (size_t chunkSize : { 1, 2, 3, 7, 64 }) {
+                istringstream strm(s);
+                StreamTokenizer t(strm, " \t\n", chunkSize);
+                if (streamTokens(t) != expectedTokens(s, " \t\n")) { ok = false; }
+            }
+        }
+        KSS_ASSERT(ok);
+
+        istringstream strm("one,two,,three");
+        StreamTokenizer t(strm, ",", 4);
+        string token;
+        KSS_ASSERT(t.hasAnother() && t.next(token) == "one");
+        stringview_t sv;
+        KSS_ASSERT(t.next(sv) == "two" && t.next(sv).empty() && t.next(token) == "three");
+        KSS_ASSERT(!t.hasAnother());
+        suppress(cerr, [&] {
+            KSS_ASSERT(terminates([&] { t.next(sv); }));
+        });
+
+        KSS_ASSERT(throwsException<invalid_argument>([] {
+            istringstream strm2("hi");
+            StreamTokenizer t2(strm2, "");
+        }));
+        KSS_ASSERT(throwsException<invalid_argument>([] {
+            istringstream strm2("hi");
+            StreamTokenizer t2(strm2, " ", 0);
+        }));
+    }),
+    make_pair("file descriptor", [] {
+        bool ok = true;
+        for (const auto& s : inputs) {
+            FILE* f = tmpfile();
+            fwrite(s.data(), 1, s.size(), f);
+            fflush(f);
+            for (size_t chunkSize : { 1, 5, 4096 }) {
+                lseek(fileno(f), 0, SEEK_SET);
+                StreamTokenizer t(fileno(f), " \t\n", chunkSize);
+                if (streamTokens(t) != expectedTokens(s, " \t\n")) { ok = false; }
+            }
+            fclose(f);
+        }
+        KSS_ASSERT(ok);
+
+        KSS_ASSERT(throwsException<system_error>([] {
+            StreamTokenizer t(-1);
+            t.hasAnother();
+        }));
+    })
+});
@@ -23,6 +23,36 @@ static TestSuite ts("strings::stringutil", {
             const auto s = format("%s is test number %.1f", "This", 5.F);
             return format("%s is test number %.1f", "This", 5.F);
         }));
+        KSS_ASSERT(format(string("%d-%s"), 7, "x") == "7-x");
+        KSS_ASSERT(throwsException<invalid_argument>([] { format(string().c_str()); }));
+        KSS_ASSERT(throwsException<invalid_argument>([] { format(string()); }));
+
+        // Test the appending format.
+        string buf = "prefix:";
+        KSS_ASSERT(&appendFormat(buf, " %d", 42) == &buf);
+        KSS_ASSERT(buf == "prefix: 42");
+        appendFormat(buf, "%s", "");
+        KSS_ASSERT(buf == "prefix: 42");
+        const string big(5000, 'z');
+        appendFormat(buf, "[%s]", big.c_str());
+        KSS_ASSERT(buf == "prefix: 42[" + big + "]");
+        buf.clear();
+        const auto capacity = buf.capacity();
+        appendFormat(buf, "%05.1f|%x", 3.14159, 255U);
+        KSS_ASSERT(buf == "003.1|ff" && buf.capacity() == capacity);
+        KSS_ASSERT(throwsException<invalid_argument>([&] { appendFormat(buf, string().c_str()); }));
+        KSS_ASSERT(buf == "003.1|ff");
+
+        // Many short appends to a string with a large reserve.
+        string log;
+        log.reserve(1 << 20);
+        const auto logCapacity = log.capacity();
+        string expected;
+        for (int i = 0; i < 10000; ++i) {
+            appendFormat(log, "line %d\n", i);
+            expected += "line " + to_string(i) + "\n";
+        }
+        KSS_ASSERT(log == expected && log.capacity() == logCapacity);
 
         // Test the trimming.
         string s = "  This is a test of whitespace trimming.   ";
@@ -45,6 +75,24 @@ static TestSuite ts("strings::stringutil", {
         KSS_ASSERT(trim(s, '.') == "This is a test of non-whitespace trimming");
         KSS_ASSERT(trim(s, 'g') == "This is a test of non-whitespace trimmin");
         KSS_ASSERT(trim(s, 'x') == "This is a test of non-whitespace trimmin");
+        s = " \t\n ";
+        KSS_ASSERT(trim(s).empty());
+        s = "xxx";
+        KSS_ASSERT(trim(s, 'x').empty());
+
+        // Test the non-modifying trims.
+        const string cs = "  \tview trimming \n";
+        KSS_ASSERT(ltrim(cs) == "view trimming \n");
+        KSS_ASSERT(rtrim(cs) == "  \tview trimming");
+        KSS_ASSERT(trim(cs) == "view trimming");
+        KSS_ASSERT(trim(cs).data() == cs.data() + 3);
+        KSS_ASSERT(cs == "  \tview trimming \n");
+        KSS_ASSERT(trim("--view--", '-') == "view");
+        KSS_ASSERT(ltrim("--view--", '-') == "view--");
+        KSS_ASSERT(rtrim("--view--", '-') == "--view");
+        KSS_ASSERT(trim("   ").empty());
+        KSS_ASSERT(trim("").empty());
+        KSS_ASSERT(trim(stringview_t("  a b  ")) == "a b");
 
         // Test the prefix and suffix.
         KSS_ASSERT(startsWith("this is the string", "this is"));
@@ -64,6 +112,14 @@ static TestSuite ts("strings::stringutil", {
         KSS_ASSERT(!endsWith("this is the string", "strong"));
         KSS_ASSERT(!endsWith("t", "out"));
         KSS_ASSERT(!endsWith("", "hi"));
+
+        const string withNul("ab\0cd", 5);
+        KSS_ASSERT(startsWith(withNul, string("ab\0c", 4)));
+        KSS_ASSERT(!startsWith(withNul, string("ab\0x", 4)));
+        KSS_ASSERT(endsWith(withNul, string("\0cd", 3)));
+        KSS_ASSERT(!endsWith(withNul, string("\0ce", 3)));
+        KSS_ASSERT(!startsWith("ab", withNul));
+        KSS_ASSERT(startsWith(stringview_t(withNul).substr(1), "b"));
     }),
     make_pair("case conversion and comparison", [] {
         {
@@ -122,6 +178,35 @@ static TestSuite ts("strings::stringutil", {
             KSS_ASSERT(toLower((const wstring&)s2) == L"this is a test");
             KSS_ASSERT(s2 == L"ThiS IS a tEst");
         }
+        {
+            // Long enough to cover full blocks, a partial block, and a block with
+            // non-ASCII bytes.
+            const string lower = "content-type: text/plain; charset=utf-8 \xc3\xa9t\xc3\xa9 [@`{] end of the header";
+            string upper = lower;
+            for (auto& ch : upper) {
+                if (ch >= 'a' && ch <= 'z') { ch = char(ch - 'a' + 'A'); }
+            }
+            KSS_ASSERT(toUpper(lower) == upper);
+            KSS_ASSERT(toLower(upper) == lower);
+            KSS_ASSERT(iequal(lower, upper) && icompare(lower, upper) == 0);
+            KSS_ASSERT(!iequal(lower, upper.substr(1)));
+            KSS_ASSERT(icompare(lower + "a", upper + "B") < 0);
+            KSS_ASSERT(icompare(lower + "[", upper + "a") < 0);
+            KSS_ASSERT(icompare(lower, upper + "x") < 0);
+
+            char buffer[64];
+            const stringview_t sv(lower.data() + 14, 10);
+            KSS_ASSERT(toUpper(sv, buffer) == buffer + 10 && string(buffer, 10) == "TEXT/PLAIN");
+            KSS_ASSERT(toLower(stringview_t("MiXeD"), buffer) == buffer + 5 && string(buffer, 5) == "mixed");
+            KSS_ASSERT(iequal("Accept-Encoding", stringview_t("accept-encoding")));
+            KSS_ASSERT(iequal(sv, "TEXT/PLAIN") && !iequal(sv, "TEXT/PLAINS"));
+            KSS_ASSERT(iequal("", "") && icompare("", "a") < 0);
+
+            // Bytes above 0x7f compare as unsigned, after all the ASCII characters.
+            KSS_ASSERT(icompare("caf\xc3\xa9", "CAF\xc3\xa8") > 0);
+            KSS_ASSERT(icompare("\xe9", "z") > 0 && icompare("Z", "\xe9") < 0);
+            KSS_ASSERT(iequal("Caf\xc3\xa9", "cAF\xc3\xa9"));
+        }
     }),
     make_pair("countOccurrencesOf", [] {
         const string s = "This is a test of AAAAAAAA substring counting seAArch.";
@@ -0,0 +1,84 @@
+//
+//  stringview.cpp
+//  unittest
+//
+//  Created by Steven W. Klassen on 2026-10-16.
+//  Copyright © 2026 Klassen Software Solutions. All rights reserved.
+//  Licensing follows the MIT License.
+//
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <kss/test/all.h>
+#include <kss/util/stringview.hpp>
+
+using namespace std;
+using namespace kss::util::strings;
+using namespace kss::test;
+
+
+static TestSuite ts("strings::StringView", {
+    make_pair("construction", [] {
+        stringview_t sv;
+        KSS_ASSERT(sv.empty() && sv.size() == 0 && sv.begin() == sv.end());
+        KSS_ASSERT(stringview_t(nullptr).empty());
+
+        const char* cstr = "hello world";
+        sv = cstr;
+        KSS_ASSERT(sv.data() == cstr && sv.size() == 11 && sv.length() == 11);
+
+        string s("hello");
+        stringview_t sv2(s);
+        KSS_ASSERT(sv2.data() == s.data() && sv2.size() == 5);
+        KSS_ASSERT(sv2.to_string() == "hello" && string(sv2) == "hello");
+
+        substring_t ss(s, 1, 3);
+        stringview_t sv3(ss);
+        KSS_ASSERT(sv3.data() == s.data()+1 && sv3 == "ell");
+
+        wstringview_t wsv(L"wide");
+        KSS_ASSERT(wsv.size() == 4 && wsv == wstring(L"wide"));
+    }),
+    make_pair("access", [] {
+        stringview_t sv("abcdef");
+        KSS_ASSERT(sv[0] == 'a' && sv.front() == 'a' && sv.back() == 'f' && sv.at(2) == 'c');
+        KSS_ASSERT(throwsException<out_of_range>([&] { sv.at(6); }));
+        KSS_ASSERT(string(sv.rbegin(), sv.rend()) == "fedcba");
+
+        sv.remove_prefix(1);
+        sv.remove_suffix(2);
+        KSS_ASSERT(sv == "bcd");
+        KSS_ASSERT(sv.substr(1) == "cd" && sv.substr(1, 1) == "c" && sv.substr(3).empty());
+        KSS_ASSERT(throwsException<out_of_range>([&] { sv.substr(4); }));
+
+        ostringstream strm;
+        strm << "[" << sv << "]";
+        KSS_ASSERT(strm.str() == "[bcd]");
+    }),
+    make_pair("comparison", [] {
+        const string s("abc");
+        stringview_t sv(s);
+        KSS_ASSERT(sv == "abc" && "abc" == sv && sv == s && s == sv);
+        KSS_ASSERT(sv != "ab" && sv != "abcd" && sv != "abd");
+        KSS_ASSERT(sv < "abd" && sv < "abcd" && "ab" < sv && sv <= "abc" && sv >= "abc");
+        KSS_ASSERT(sv > "ab" && sv > stringview_t() && stringview_t() < sv);
+        KSS_ASSERT(sv.compare("abc") == 0 && sv.compare("b") < 0 && sv.compare("ab") > 0);
+        KSS_ASSERT(stringview_t() == "" && stringview_t().compare(stringview_t()) == 0);
+
+        KSS_ASSERT(StringHash()("abc") == StringHash()(s) && StringHash()(sv) == StringHash()(string("abc")));
+        KSS_ASSERT(StringHash()("abc") != StringHash()("abd"));
+    }),
+    make_pair("searching", [] {
+        stringview_t sv("one two three");
+        KSS_ASSERT(sv.find('t') == 4 && sv.find('t', 5) == 8 && sv.find('x') == stringview_t::npos);
+        KSS_ASSERT(sv.find("two") == 4 && sv.find("three") == 8 && sv.find("") == 0);
+        KSS_ASSERT(sv.find("threes") == stringview_t::npos && sv.find("one", 1) == stringview_t::npos);
+        KSS_ASSERT(sv.rfind('e') == 12 && sv.rfind('e', 11) == 11 && sv.rfind('o', 2) == 0);
+        KSS_ASSERT(sv.rfind('x') == stringview_t::npos);
+        KSS_ASSERT(sv.find_first_of(" w") == 3 && sv.find_first_of("xyz") == stringview_t::npos);
+        KSS_ASSERT(sv.find_first_not_of("one ") == 4);
+        KSS_ASSERT(sv.find_last_not_of("e") == 10 && stringview_t("aaa").find_last_not_of("a") == stringview_t::npos);
+    })
+});
@@ -8,6 +8,8 @@
 //
 
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include <kss/test/all.h>
 #include <kss/util/tokenizer.hpp>
@@ -67,5 +69,80 @@ static NoParallelTestSuite ts("strings::tokenizer", {
     make_pair("empty", [] {
         Tokenizer t("", " ");
         KSS_ASSERT(t.begin() == t.end());
+    }),
+    make_pair("view tokenizer", [] {
+        const string input("the  quick\nbrown\t\tfox ");
+        ViewTokenizer t(input, " \t\n");
+        const vector<string> tokens { "the", "", "quick", "brown", "", "fox", "" };
+        vector<string> actual;
+        for (stringview_t sv : t) {
+            KSS_ASSERT(sv.data() >= input.data() && sv.data() + sv.size() <= input.data() + input.size());
+            actual.push_back(sv.to_string());
+        }
+        KSS_ASSERT(actual == tokens);
+
+        // Check that the tokens match those of Tokenizer, including the edge cases.
+        for (const string s : { "", " ", "  ", "a", "a ", " a", "a  b", "skip the first bit skip" }) {
+            Tokenizer t1(s, " ");
+            ViewTokenizer t2(s, " ");
+            vector<string> v1, v2;
+            for (const auto& token : t1) {
+                v1.push_back(token);
+            }
+            for (auto it = t2.begin(); it != t2.end(); ++it) {
+                v2.push_back(it->to_string());
+            }
+            KSS_ASSERT(v1 == v2);
+        }
+
+        ViewTokenizer t3("skip the first bit skip", " ", 5, 19);
+        stringview_t sv;
+        KSS_ASSERT(t3.next(sv) == "the" && t3.next(sv) == "first" && t3.next(sv) == "bit");
+        KSS_ASSERT(t3.hasAnother() && t3.next(sv).empty() && !t3.hasAnother());
+        suppress(cerr, [&] {
+            KSS_ASSERT(terminates([&] { t3.next(sv); }));
+        });
+
+        string s("one,two");
+        substring_t ss(s, 4, 3);
+        ViewTokenizer t4(ss, ",");
+        KSS_ASSERT(t4.next(sv) == "two" && sv.data() == s.data() + 4 && !t4.hasAnother());
+
+        KSS_ASSERT(throwsException<invalid_argument>([] {
+            ViewTokenizer t5("hi", "");
+        }));
+    }),
+    make_pair("parallel tokenize", [] {
+        // The results must match Tokenizer for any number of chunks.
+        bool ok = true;
+        for (const string s : { "", " ", "  ", "a", "a ", " a", "a  b", "the quick,brown fox,,jumped ",
+                                "no delimiters at all", ",,,,,,,," }) {
+            vector<string> expected;
+            for (const auto& token : Tokenizer(s, " ,")) {
+                expected.push_back(token);
+            }
+            for (size_t numChunks : { 0, 1, 2, 3, 5, 100 }) {
+                vector<string> actual;
+                for (const auto& sv : parallelTokenize(s, " ,", numChunks)) {
+                    actual.push_back(sv.to_string());
+                }
+                if (actual != expected) { ok = false; }
+            }
+        }
+        KSS_ASSERT(ok);
+
+        const string s("a,b,c,d,e,f");
+        const auto tokens = parallelTokenize(s, ",", 3);
+        KSS_ASSERT(tokens.size() == 6 && tokens[2] == "c" && tokens[2].data() == s.data() + 4);
+
+        vector<vector<stringview_t>> chunks;
+        parallelTokenize(s, ",", 3, [&](const vector<stringview_t>& chunkTokens) {
+            chunks.push_back(chunkTokens);
+        });
+        KSS_ASSERT(chunks.size() == 3 && chunks[0].front() == "a" && chunks[2].back() == "f");
+
+        KSS_ASSERT(throwsException<invalid_argument>([] {
+            parallelTokenize("hi", "");
+        }));
     })
 });